@@ -0,0 +1,128 @@
+#pragma once
+
+#include "texture.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Frames of one TexturePacker sprite sheet, parsed once.
+ *
+ * Characters used to keep the json DOM around and walk it with four string keyed lookups
+ * on every frame change, with the frame number itself kept as a string. The clip stores
+ * the frame rects with their uvs already normalised, indexed by an integer frame.
+ *
+ * Clips are immutable and shared through AnimationClipLibrary, the sheet texture is kept
+ * alive by the clip.
+ *
+ * The uv rects are also uploaded once into a buffer texture, one RGBA32F texel per frame,
+ * so character_shader looks the rect up from the frame index and animation playback needs
+ * no per frame vertex uploads.
+ */
+class AnimationClip
+{
+public:
+    struct Frame
+    {
+        // (u0, v0, u1, v1) in the sheet texture
+        glm::vec4 uvRect;
+        // Quad size in pixels, only the trimmed rect when the sheet is packed with trimming
+        glm::vec2 size;
+        // Bottom left of the quad inside the untrimmed frame in pixels, y up
+        glm::vec2 offset;
+        // Untrimmed frame size in pixels, what placement and collision work with
+        glm::vec2 sourceSize;
+    };
+
+    // Loaded through SpriteSheetData, from the binary next to the json when up to date.
+    // Frames may be trimmed but not rotated.
+    AnimationClip(const std::string& jsonPath, std::shared_ptr<Texture> texturesSheet);
+    ~AnimationClip();
+
+    AnimationClip(const AnimationClip&) = delete;
+    AnimationClip& operator=(const AnimationClip&) = delete;
+
+    unsigned int getFrameCount() const
+    {
+        return static_cast<unsigned int>(m_frames.size());
+    }
+
+    const Frame& getFrame(unsigned int frameIndex) const
+    {
+        return m_frames[frameIndex];
+    }
+
+    Texture* getTexturesSheet() const
+    {
+        return m_textures_sheet.get();
+    }
+
+    // samplerBuffer of the frame uv rects, indexed by frame
+    GLuint getFramesTexture() const
+    {
+        return m_frames_texture;
+    }
+
+    // Unit quad to the frame's rect inside its untrimmed frame, turned by 180 degrees for the
+    // u flipped plane layout of character_shader. flip moves the rect to its mirrored place in
+    // the untrimmed frame, so untrimmed and trimmed frames land on the same pixels either way.
+    // The image itself is mirrored by swapping u0 and u1, see getQuadUVRect().
+    static glm::mat4 getQuadTransform(const Frame& frame, bool flip);
+
+    // uvRect with u0 and u1 swapped when flip
+    static glm::vec4 getQuadUVRect(const Frame& frame, bool flip);
+
+private:
+    std::vector<Frame> m_frames;
+    std::shared_ptr<Texture> m_textures_sheet;
+
+    // Frame uv rects buffer and its buffer texture
+    GLuint m_frames_tbo;
+    GLuint m_frames_texture;
+};
+
+/*
+ * Playback state of one instance of a shared clip.
+ */
+class AnimationPlayback
+{
+public:
+    AnimationPlayback();
+
+    // Restart from the first frame of clip
+    void play(const AnimationClip* clip);
+
+    // Step to the next frame once more than frameDuration has passed since the last step,
+    // wraps around at the end of the clip. Returns true if the frame changed.
+    bool advance(float deltaTime, float frameDuration);
+
+    const AnimationClip* getClip() const
+    {
+        return m_clip;
+    }
+
+    unsigned int getFrameIndex() const
+    {
+        return m_frame_index;
+    }
+
+    const AnimationClip::Frame& getFrame() const
+    {
+        return m_clip->getFrame(m_frame_index);
+    }
+
+    bool isLastFrame() const
+    {
+        return m_frame_index + 1 == m_clip->getFrameCount();
+    }
+
+private:
+    const AnimationClip* m_clip;
+    unsigned int m_frame_index;
+    float m_time_accumulator;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "animationclip.hpp"
+
+#include <memory>
+#include <string>
+
+/*
+ * Process-wide animation clip library keyed by the sprite sheet json.
+ *
+ * Every monster used to parse the stand, walk and killed json again in its constructor and
+ * keep the three DOMs for its lifetime. acquire() parses each sheet once and hands out
+ * shared handles to the immutable clip, instances only keep their AnimationPlayback. The
+ * clip, and with it the sheet texture, is released once the last handle goes away.
+ */
+class AnimationClipLibrary
+{
+public:
+    static std::shared_ptr<const AnimationClip> acquire(const std::string& jsonPath,
+                                                        const std::string& texturesSheetPath);
+
+    static unsigned int getLoadedClipsCount();
+
+private:
+    AnimationClipLibrary() {} // Static only.
+};
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 #include <glm.hpp>
@@ -14,9 +14,9 @@ class Background : public GeometryNode
 public:
     /*
      * For Scene Zero, Only a simple background is needed,
-     * for scene one and scene two, far and mid are both needed.
+     * scene one and scene two scroll far and mid ParallaxLayers instead.
      */
-    enum class BackgroundTextureType { Mid, Far, SceneZero };
+    enum class BackgroundTextureType { SceneZero };
 
     Background(const std::string& name,
                ShaderProgram* shader,
@@ -25,27 +25,23 @@ public:
                BackgroundTextureType textureType);
     ~Background() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_texture->getTextureId()};
+    }
 
     glm::vec2 getTextureGeo()
     {
-        return glm::vec2(m_texture.getTextureWidth(), m_texture.getTextureHeight());
+        return glm::vec2(m_texture->getTextureWidth(), m_texture->getTextureHeight());
     }
 
 private:
     ShaderProgram* m_shader;
 
-    Texture m_texture;
+    std::shared_ptr<Texture> m_texture;
 
     GLfloat m_plane_width;
     GLfloat m_plane_height;
-
-    // Attribute
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // Background Vertex Array Object
-    GLuint m_background_vao;
-    // Background Vertex Buffer Object
-    GLuint m_background_vbo;
 };
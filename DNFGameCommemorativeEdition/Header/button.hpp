@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 #include <glm.hpp>
@@ -32,7 +32,8 @@ public:
     Button(const std::string& name, ShaderProgram* shader, ButtonTextureType textureType);
     ~Button() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+    RenderState getRenderState() override;
     void translate(const glm::vec3& amount) override;
 
     // If mouse is on top of the Button.
@@ -51,7 +52,7 @@ public:
 
     glm::vec2 getTextureGeo()
     {
-        return glm::vec2(m_texture_normal.getTextureWidth(), m_texture_normal.getTextureHeight());
+        return glm::vec2(m_texture_normal->getTextureWidth(), m_texture_normal->getTextureHeight());
     }
 
     // For center buttons in certain scene
@@ -60,26 +61,21 @@ public:
     void cleanMovement();
 
 private:
+    // Normal or hover art, depending on the type and hover state
+    Texture* getCurrentTexture();
+
     ShaderProgram* m_shader;
 
-    Texture m_texture_normal;
-    Texture m_texture_hover;
+    std::shared_ptr<Texture> m_texture_normal;
+    std::shared_ptr<Texture> m_texture_hover;
 
     GLfloat m_plane_width;
     GLfloat m_plane_height;
 
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
     // Help to process mouse hover, click
     bool m_button_is_hovered;
     GLfloat m_button_dx;
     GLfloat m_button_dy;
 
     ButtonTextureType m_current_button_t_type;
-
-    // Button Vertex Array Object
-    GLuint m_button_vao;
-    // Button Vertex Buffer Object
-    GLuint m_button_vbo;
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+/*
+ * Owns the std140 "Camera" uniform block (P, V) shared by the main, shadow and particle
+ * shaders.
+ *
+ * P and V used to be uploaded into every program each frame, which meant one program switch
+ * per Player, NPC, Monster and particle generator. The buffer is now filled once per frame
+ * and every program reads it through the same binding point.
+ */
+class CameraUniformBuffer
+{
+public:
+    CameraUniformBuffer();
+    ~CameraUniformBuffer();
+
+    void init();
+
+    void update(const glm::mat4& proj, const glm::mat4& view);
+
+    // Last uploaded matrices, to restore the camera after an offscreen pass
+    const glm::mat4& getProj() const
+    {
+        return m_proj;
+    }
+
+    const glm::mat4& getView() const
+    {
+        return m_view;
+    }
+
+    // Attach the program's camera block (if any) to the shared binding point
+    static void bindProgram(ShaderProgram& program);
+
+private:
+    GLuint m_ubo;
+
+    glm::mat4 m_proj;
+    glm::mat4 m_view;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+#include "animationclip.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Draws animated characters (player, skill effect, NPC, monsters) as instances of one
+ * unit quad.
+ *
+ * Every character used to own a VAO, a position VBO and a texcoord VBO rewritten with
+ * glBufferSubData on each frame change, then issue its own draw. They now queue an instance
+ * (model matrix, clip, frame index, flip, hit and outline flags) and flush() streams all of
+ * them into one instance buffer. The frame uv rect is looked up in the vertex shader from
+ * the clip's frame buffer texture and flipped there as well.
+ *
+ * Up to maxClipsPerDraw clips get their sprite sheet and frame table bound to their own
+ * texture units for a draw and each instance picks its clip in the shader, so consecutive
+ * characters are drawn in submission order with one glDrawArraysInstanced no matter how
+ * many there are or which animation they play. Like SpriteBatch, flush() is needed before
+ * anything is drawn outside of the batch.
+ */
+class CharacterBatch
+{
+public:
+    // Size of the sampler arrays in character_shader
+    static constexpr unsigned int maxClipsPerDraw {8};
+
+    struct Stats
+    {
+        unsigned int instances {0};
+        unsigned int drawCalls {0};
+    };
+
+    CharacterBatch();
+    ~CharacterBatch();
+
+    // flip mirrors the frame image, see AnimationClip::getQuadUVRect()
+    void submit(const glm::mat4& modelMat,
+                const AnimationClip* clip,
+                unsigned int frameIndex,
+                bool flip,
+                bool hit = false,
+                bool outline = false);
+
+    bool isEmpty() const
+    {
+        return m_instances.empty();
+    }
+
+    // Draw every queued character, returns false if there was nothing to draw.
+    // Leaves the character program bound.
+    bool flush();
+
+    void resetStats();
+    const Stats& getStats() const;
+
+private:
+    struct Instance
+    {
+        glm::mat4 modelMat;
+        const AnimationClip* clip;
+        GLfloat frameIndex;
+        GLfloat flags;
+    };
+
+    // Consecutive instances drawn with the same set of clips
+    struct Draw
+    {
+        size_t firstInstance;
+        size_t instanceCount;
+        const AnimationClip* clips[maxClipsPerDraw];
+        unsigned int clipsCount;
+    };
+
+    // base is the byte offset of the first instance in the stream buffer
+    void setInstanceAttribPointers(GLintptr base);
+
+    std::shared_ptr<ShaderProgram> m_character_shader;
+
+    GLint m_model_attrib_pos;
+    GLint m_clip_frame_and_flags_attrib_pos;
+
+    std::vector<Instance> m_instances;
+    std::vector<Draw> m_draws;
+    // Model matrix, clip slot, frame index and flags per instance
+    std::vector<GLfloat> m_instance_data;
+
+    // CharacterBatch Vertex Array Object
+    GLuint m_character_batch_vao;
+
+    Stats m_stats;
+};
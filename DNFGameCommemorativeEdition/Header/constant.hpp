@@ -1,9 +1,12 @@
-#pragma once
+﻿#pragma once
 
 #include <string>
 #include <limits>
 #include <cmath>
 #include <random>
+#include <vector>
+
+#include "glshim.hpp"
 
 #include <glm.hpp>
 #include <gtx/string_cast.hpp>
@@ -96,8 +99,8 @@ const std::string cursorPath {"Resource/Texture/Cursor/cursor.png"};
 
 namespace StringContant {
 // Wide character string is used here for chinese names
-const std::wstring fancyPlayerChineseName {L"֮"};
-const std::wstring fancyNPCChineseName {L"ĪаϹ"};
+const std::wstring fancyPlayerChineseName {L"炙琰之灵"};
+const std::wstring fancyNPCChineseName {L"莫邪的老公"};
 const std::string npcName {"npc_linus"};
 const std::string playerName {"player_fire"};
 const std::string playerSkillEffectName {"player_effect"};
@@ -116,6 +119,8 @@ const std::string sceneOneBackgroundName {"scene_one_background"};
 const std::string sceneTwoBackgroundName {"scene_two_background"};
 const std::string sceneOneFloorName {"scene_one_floor"};
 const std::string sceneTwoFloorName {"scene_two_floor"};
+const std::string sceneOneStaticLayerName {"scene_one_static_layer"};
+const std::string sceneTwoStaticLayerName {"scene_two_static_layer"};
 const std::string sceneOneMapName {"scene_one_map"};
 const std::string sceneTwoMapName {"scene_two_map"};
 const std::string sceneOneFloorObjName {"scene_one_floor_obj"};
@@ -128,13 +133,20 @@ namespace RatioContant {
 const float backgroundHeightScaleRatio {5.0f / 8.0f};
 const float floorHeightScaleRatio {3.5f / 8.0f};
 const float attachOffset {1.1f};
+// Background art moves this much per pixel the camera moves
+const float backgroundFarScrollRatio {0.4f};
+const float backgroundMidScrollRatio {0.7f};
 } // namespace RatioContant
 
+namespace StaticLayerCache {
+// Render the floor and the layer one floor objs once into offscreen tiles,
+// off draws them straight from the scene graph every frame
+const bool enabled {true};
+} // namespace StaticLayerCache
+
 namespace FPS {
-// FPS
+// Frame rate cap (60, 120, 144 ...), 0 runs uncapped. --fps N overrides it at launch
 const float fps {60.0f};
-// One frame takes how many milliseconds
-const float frameDelay {1000.0f / fps};
 } // namespace FPS
 
 namespace Scene {
@@ -162,7 +174,7 @@ const float fontTextLineHeight {27.0f};
 const std::string chineseFontPath {"Resource/Fonts/FZFangSong-Z02T-Regular.ttf"};
 const std::string englishFontPath {"Resource/Fonts/ARLRDBD.ttf"};
 // Wide character string is used here for chinese names
-const std::wstring chineseLetters {L"֮ĪаϹ"};
+const std::wstring chineseLetters {L"炙琰之灵莫邪的老公"};
 const std::string englishLetters {"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ,.! ?"};
 } // namespace Fonts
 
@@ -194,8 +206,8 @@ const std::string sideDoorBossPath {"Resource/Texture/Door/sideBossDoor.png"};
 const std::string treePath {"Resource/Texture/FloorObj/tree.png"};
 const std::string flowerOnePath {"Resource/Texture/FloorObj/flowerOne.png"};
 const std::string flowerTwoPath {"Resource/Texture/FloorObj/flowerTwo.png"};
-const std::string backgroundFarPath {"Resource/Texture/Background/backgroundFar.png"};
-const std::string backgoundMidPath {"Resource/Texture/Background/backgoundMid.png"};
+const std::string backgroundFarPath {"Resource/Texture/Background/BackgroundFar.png"};
+const std::string backgoundMidPath {"Resource/Texture/Background/BackgoundMid.png"};
 const std::string sceneZeroBackgroundPath {"Resource/Texture/Background/sceneZeroBackground.png"};
 const std::string grassTilePath {"Resource/Texture/Tiles/grassTile.png"};
 const std::string roadTilePath {"Resource/Texture/Tiles/roadTile.png"};
@@ -223,16 +235,97 @@ const std::string monsterKilledPNGPath {"Resource/Texture/Monster/Killed/killed_
 const std::string monsterKilledJsonPath {"Resource/Texture/Monster/Killed/killed_spritesheet.json"};
 } // namespace TexturePath
 
+// Small static art drawn through SpriteBatch, packed into one page at startup
+namespace TextureAtlasContent {
+const std::vector<std::string> filePaths {TexturePath::dnfLogoPath,
+                                          TexturePath::mouseLeftPath,
+                                          TexturePath::xKeyPath,
+                                          TexturePath::zKeyPath,
+                                          TexturePath::arrowKeyPath,
+                                          TexturePath::moveLabelPath,
+                                          TexturePath::attackLabelPath,
+                                          TexturePath::interactLabelPath,
+                                          TexturePath::exitButtonNormalUIPath,
+                                          TexturePath::exitButtonHoverUIPath,
+                                          TexturePath::controlButtonNormalUIPath,
+                                          TexturePath::controlButtonHoverUIPath,
+                                          TexturePath::backButtonNormalUIPath,
+                                          TexturePath::backButtonHoverUIPath,
+                                          TexturePath::playButtonNormalUIPath,
+                                          TexturePath::playButtonHoverUIPath,
+                                          TexturePath::victoryPNGPath,
+                                          TexturePath::dialogUIPath,
+                                          TexturePath::npcDialogHeadPath,
+                                          TexturePath::doorBushPath,
+                                          TexturePath::sideDoorNormalPath,
+                                          TexturePath::sideDoorBossPath,
+                                          TexturePath::treePath,
+                                          TexturePath::flowerOnePath,
+                                          TexturePath::flowerTwoPath,
+                                          TexturePath::grassTilePath,
+                                          TexturePath::roadTilePath};
+
+const int pageWidth {2048};
+const int maxPageHeight {2048};
+// Gutter around every sub-image, filled with its edge pixels
+const int padding {2};
+} // namespace TextureAtlasContent
+
+// Binary sprite sheet metadata written next to the json by SpriteSheetConverter
+namespace SpriteSheetContent {
+const std::vector<std::string> jsonPaths {TexturePath::npcJsonPath,
+                                          TexturePath::playerStandJsonPath,
+                                          TexturePath::playerWalkJsonPath,
+                                          TexturePath::playerBasicAttackJsonPath,
+                                          TexturePath::playerSKillJsonPath,
+                                          TexturePath::playerSKillEffectJsonPath,
+                                          TexturePath::monsterStandJsonPath,
+                                          TexturePath::monsterWalkJsonPath,
+                                          TexturePath::monsterKilledJsonPath};
+
+const std::string binaryExtension {".ssb"};
+} // namespace SpriteSheetContent
+
 namespace ShadowShaderPath {
 const std::string vertexShader {"Resource/Shaders/shadow_shader.vert"};
 const std::string fragmentShader {"Resource/Shaders/shadow_shader.frag"};
 } // namespace ShadowShaderPath
 
+namespace CharacterShaderPath {
+const std::string vertexShader {"Resource/Shaders/character_shader.vert"};
+const std::string fragmentShader {"Resource/Shaders/character_shader.frag"};
+} // namespace CharacterShaderPath
+
 namespace ParticleShaderPath {
 const std::string vertexShader {"Resource/Shaders/particles_shader.vert"};
 const std::string fragmentShader {"Resource/Shaders/particles_shader.frag"};
 } // namespace ParticleShaderPath
 
+namespace CameraBlock {
+const std::string blockName {"Camera"};
+const unsigned int bindingPoint {0};
+} // namespace CameraBlock
+
+// The one plane every sprite is drawn on, two triangles, u flipped.
+// Instanced shaders build the same corners from gl_VertexID, SpriteBatch expands it on the CPU.
+namespace UnitQuad {
+// clang-format off
+const GLfloat corners[] =
+{
+    // triangle 1
+    // x,    y,
+    0.0f, 1.0f,
+    1.0f, 1.0f,
+    0.0f, 0.0f,
+    // triangle 2
+    1.0f, 0.0f,
+    1.0f, 1.0f,
+    0.0f, 0.0f
+};
+// clang-format on
+const int verticesCount {6};
+} // namespace UnitQuad
+
 namespace Conversation {
 const std::string sceneOneS1 {"Where.....am I ? ? ?"};
 const std::string sceneOneS2 {"I...should be at the Kether."};
@@ -279,6 +372,12 @@ const std::string x {"x"};
 const std::string y {"y"};
 const std::string w {"w"};
 const std::string h {"h"};
+const std::string trimmed {"trimmed"};
+const std::string rotated {"rotated"};
+const std::string spriteSourceSize {"spriteSourceSize"};
+const std::string sourceSize {"sourceSize"};
+const std::string meta {"meta"};
+const std::string size {"size"};
 } // namespace SSJsonKeys
 
 namespace GLFWArrowKeyRemap {
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 /*
@@ -13,12 +13,17 @@ public:
     Dialog(ShaderProgram* shader, GLfloat windowWidth, GLfloat windowHeight);
     ~Dialog() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_texture->getTextureId()};
+    }
 
     glm::vec2 getOriginTrans();
     glm::vec2 getTextureGeo()
     {
-        return glm::vec2(m_texture.getTextureWidth(), m_texture.getTextureHeight());
+        return glm::vec2(m_texture->getTextureWidth(), m_texture->getTextureHeight());
     }
 
     void cleanMovement();
@@ -32,13 +37,5 @@ private:
     GLfloat m_window_width;
     GLfloat m_window_height;
 
-    Texture m_texture;
-
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // Dialog Vertex Array Object
-    GLuint m_dialog_vao;
-    // Dialog Vertex Buffer Object
-    GLuint m_dialog_vbo;
+    std::shared_ptr<Texture> m_texture;
 };
@@ -20,7 +20,12 @@ public:
                CharType charType = CharType::English);
     ~DialogChar() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_char_info.textureID};
+    }
 
 private:
     ShaderProgram* m_shader;
@@ -30,16 +35,5 @@ private:
 
     Fonts::CharacterInfo m_char_info;
 
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // DialogChar Vertex Array Object
-    GLuint m_dialog_char_vao;
-    // DialogChar Vertex Buffer Object
-    GLuint m_dialog_char_vbo;
-
-    // Uniform drawText id
-    GLuint m_draw_text_id;
-
     CharType m_char_type;
 };
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 class DialogImage : public GeometryNode
@@ -10,7 +10,12 @@ public:
     DialogImage(ShaderProgram* shader);
     ~DialogImage() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_texture->getTextureId()};
+    }
 
     void setDialogOrigin(glm::vec2 dialogOrigin);
 
@@ -21,7 +26,7 @@ public:
 
     glm::vec2 getTextureGeo()
     {
-        return glm::vec2(m_texture.getTextureWidth(), m_texture.getTextureHeight());
+        return glm::vec2(m_texture->getTextureWidth(), m_texture->getTextureHeight());
     }
 
     void cleanMovement();
@@ -36,13 +41,5 @@ private:
     GLfloat m_plane_width;
     GLfloat m_plane_height;
 
-    Texture m_texture;
-
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // Dialog Image Vertex Array Object
-    GLuint m_dialog_img_vao;
-    // Dialog Image Vertex Buffer Object
-    GLuint m_dialog_img_vbo;
+    std::shared_ptr<Texture> m_texture;
 };
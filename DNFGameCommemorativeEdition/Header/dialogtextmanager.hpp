@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #include "shaderprogram.hpp"
 #include "constant.hpp"
@@ -57,10 +57,10 @@ private:
     // Free type lib
     FT_Library m_free_type_lib;
 
-    // Glyph (ܽ) texture id eng map.
+    // Glyph (格蕾芙) texture id eng map.
     std::map<char, Fonts::CharacterInfo> m_glyph_tex_map_eng;
 
-    // Glyph (ܽ) texture id ch map.
+    // Glyph (格蕾芙) texture id ch map.
     std::map<wchar_t, Fonts::CharacterInfo> m_glyph_tex_map_ch;
 
     glm::vec2 m_char_trans;
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 /*
@@ -16,11 +16,16 @@ public:
     FloorObj(const std::string& name, ShaderProgram* shader, FloorObjType textureType);
     ~FloorObj() {}
 
-    void draw() override;
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_texture->getTextureId()};
+    }
 
     glm::vec2 getTextureGeo()
     {
-        return glm::vec2(m_texture.getTextureWidth(), m_texture.getTextureHeight());
+        return glm::vec2(m_texture->getTextureWidth(), m_texture->getTextureHeight());
     }
 
     glm::vec2 getCollisionWH()
@@ -47,17 +52,9 @@ private:
     GLfloat m_plane_width;
     GLfloat m_plane_height;
 
-    Texture m_texture;
-
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
+    std::shared_ptr<Texture> m_texture;
 
     FloorObjType m_floor_obj_type;
 
-    // Floor Obj Vertex Array Object
-    GLuint m_floor_obj_vao;
-    // Floor Obj Vertex Buffer Object
-    GLuint m_floor_obj_vbo;
-
     float m_floor_obj_collide_height;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+
+/*
+ * FrameScheduler
+ *
+ * Paces the main loop to a target frame rate on the wall clock (steady_clock), and measures
+ * the delta time the game advances by.
+ *
+ * Frames are due on a fixed grid of deadlines. The wait sleeps in short steps until the
+ * deadline is closer than the sleep overshoot seen so far, then spins the rest of the way,
+ * so coarse OS timers do not turn into late frames. A loop that falls more than a frame
+ * behind starts a new grid rather than rushing to catch up.
+ */
+class FrameScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        unsigned int frames {0};
+        double totalMs {0.0};
+        double totalSquaredMs {0.0};
+        double worstMs {0.0};
+    };
+
+    // 0 for uncapped
+    explicit FrameScheduler(float targetFps);
+
+    void setTargetFps(float targetFps);
+    float getTargetFps() const;
+
+    // Right before the first frame
+    void start();
+
+    // Wait for the next deadline, returns the wall clock seconds since the last call
+    float endFrame();
+
+    const Stats& getStats() const;
+    void printStats() const;
+
+private:
+    void waitUntil(Clock::time_point deadline);
+
+    float m_target_fps;
+    Clock::duration m_frame_period;
+
+    Clock::time_point m_next_deadline;
+    Clock::time_point m_last_frame_end;
+
+    // Worst recent overshoot of a short sleep, spin for anything shorter
+    Clock::duration m_sleep_overshoot;
+
+    Stats m_stats;
+};
@@ -2,10 +2,12 @@
 
 #include "gamewindow.hpp"
 #include "shaderprogram.hpp"
+#include "camerauniformbuffer.hpp"
 #include "background.hpp"
 #include "scenemanager.hpp"
 
-#include <GL/glew.h>
+#include "glshim.hpp"
+
 #include <GLFW/glfw3.h>
 
 #include <glm.hpp>
@@ -22,6 +24,7 @@ public:
 
     static void enableKeyBoardEvent(bool enable);
     static bool getEnableKeyBoardEvent();
+    // nullptr when there is no sound device (headless boxes), the game runs silent then
     static irrklang::ISoundEngine* getSoundEngine();
 
 protected:
@@ -50,10 +53,11 @@ protected:
     std::unique_ptr<SceneManager> m_scene_manager;
 
     ShaderProgram m_shader;
-    GLint P_uni; // Uniform location for Projection matrix.
-    GLint V_uni; // Uniform location for View matrix.
     GLint M_uni; // Uniform location for Model matrix.
 
+    // P and V for every program, see shader.vert
+    CameraUniformBuffer m_camera_ubo;
+
     // Matrices controlling the camera and projection.
     glm::mat4 m_proj;
     glm::mat4 m_view;
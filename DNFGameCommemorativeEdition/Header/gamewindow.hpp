@@ -1,6 +1,10 @@
 #pragma once
 
-#include <GL/glew.h>
+#include "framescheduler.hpp"
+#include "headlesscontext.hpp"
+
+#include "glshim.hpp"
+
 #include <GLFW/glfw3.h>
 
 #include <string>
@@ -15,6 +19,18 @@ class GameWindow
 public:
     virtual ~GameWindow();
 
+    /*
+     * Launch options:
+     *   --fps N                frame rate cap, 0 for uncapped, fps by default
+     *   --vsync                pace on the monitor refresh instead of the frame rate cap
+     *   --headless             no visible window, no vsync, uncapped unless --fps is given
+     *   --frames N             frames to run headless before quitting
+     *   --dump-frames DIR      write every headless frame to DIR as ppm
+     *
+     * With HEADLESS_EGL, --headless renders into an EGL pbuffer and needs no window system
+     * (see HeadlessContext). Without it the context lives in a hidden GLFW window, which
+     * still needs a desktop session.
+     */
     static void launch(int argc,
                        char** argv,
                        GameWindow* window,
@@ -63,12 +79,24 @@ private:
 
     GLFWmonitor* m_monitor;
 
+    // Headless runs: no window with HEADLESS_EGL (m_window stays null), a hidden one
+    // otherwise, fixed number of frames
+    bool m_headless;
+    int m_headless_frames;
+#if (HEADLESS_EGL)
+    HeadlessContext m_headless_context;
+#endif
+    // Empty for no frame dumps
+    std::string m_dump_frames_dir;
+
+    bool m_vsync;
+    FrameScheduler m_frame_scheduler;
+
     static std::shared_ptr<GameWindow> getInstance();
 
-    void run(int width,
-             int height,
-             const std::string& windowTitle,
-             float desiredFramesPerSecond = 60.0f);
+    void parseLaunchOptions(int argc, char** argv);
+
+    void run(int width, int height, const std::string& windowTitle);
 
     //-- Callback functions to be registered with GLFW:
     static void errorCallback(int error, const char* description);
@@ -82,4 +110,12 @@ private:
     void registerGlfwCallBacks();
 
     void centerWindow();
+
+    // Create the window, or the headless context, and make its context current
+    bool createContext(int width, int height, const std::string& windowTitle);
+    bool shouldClose(int frame) const;
+    void swapBuffers();
+
+    // Write the back buffer as a binary ppm into m_dump_frames_dir
+    void dumpFrame(int frame);
 };
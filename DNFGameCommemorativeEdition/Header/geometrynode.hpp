@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scenenode.hpp"
+#include "spritebatch.hpp"
 
 class GeometryNode : public SceneNode
 {
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+// Route the engine's GL calls through GLShim, define GL_SHIM=1 in the project to turn it on
+#ifndef GL_SHIM
+#define GL_SHIM 0
+#endif
+
+// Build GLShim without GLEW, Record is then the only mode (the scene tests link it that way)
+#ifndef GL_SHIM_RECORD_ONLY
+#define GL_SHIM_RECORD_ONLY 0
+#endif
+
+/*
+ * GlShim
+ *
+ * Layer between the engine and GLEW. With GL_SHIM on, the macros at the bottom of this file
+ * send every GL call the engine makes through here. Each call is counted, then either passed
+ * on to GL (PassThrough) or dropped (Record).
+ *
+ * Record needs no GL context at all. Names come from a counter, shaders compile, programs
+ * link and report the uniforms and attributes declared in their sources, buffers are backed
+ * by host memory so they can be mapped, and every query gets an answer the engine accepts.
+ * Nothing is drawn.
+ *
+ * Counters are per frame, beginFrame() closes the current one.
+ */
+class GLShim
+{
+public:
+    enum class Mode { PassThrough, Record };
+
+    struct Stats
+    {
+        unsigned int drawCalls {0};
+        // Buffer, vertex array, texture and framebuffer binds
+        unsigned int binds {0};
+        unsigned int programSwitches {0};
+        unsigned int uniformUploads {0};
+        // Enable, blend, depth, viewport and the like
+        unsigned int stateChanges {0};
+        size_t bufferUploadBytes {0};
+        size_t textureUploadBytes {0};
+    };
+
+    // Set before the first GL call, names from one mode mean nothing to the other
+    static void setMode(Mode mode);
+    static Mode getMode();
+
+    // Per frame counters
+    static void beginFrame();
+    static const Stats& getStats();
+    static void printStats();
+
+    // Writes through a persistently mapped buffer never go through a GL call
+    static void countMappedUpload(size_t bytes);
+
+    // Draw
+    static void drawArrays(GLenum mode, GLint first, GLsizei count);
+    static void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances);
+
+    // Binds
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    static void bindVertexArray(GLuint array);
+    static void bindTexture(GLenum target, GLuint texture);
+    static void bindFramebuffer(GLenum target, GLuint framebuffer);
+    static void useProgram(GLuint program);
+
+    // Uniforms
+    static void uniform1i(GLint location, GLint value);
+    static void uniform1f(GLint location, GLfloat value);
+    static void uniform1iv(GLint location, GLsizei count, const GLint* value);
+    static void uniform2fv(GLint location, GLsizei count, const GLfloat* value);
+    static void uniform3fv(GLint location, GLsizei count, const GLfloat* value);
+    static void uniform4fv(GLint location, GLsizei count, const GLfloat* value);
+    static void uniformMatrix4fv(GLint location,
+                                 GLsizei count,
+                                 GLboolean transpose,
+                                 const GLfloat* value);
+    static void uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint binding);
+
+    // Buffers and vertex arrays
+    static void genBuffers(GLsizei n, GLuint* buffers);
+    static void deleteBuffers(GLsizei n, const GLuint* buffers);
+    static void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    static void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+    static void bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+    static void* mapBufferRange(GLenum target,
+                                GLintptr offset,
+                                GLsizeiptr length,
+                                GLbitfield access);
+    static GLboolean unmapBuffer(GLenum target);
+    static void genVertexArrays(GLsizei n, GLuint* arrays);
+    static void deleteVertexArrays(GLsizei n, const GLuint* arrays);
+    static void enableVertexAttribArray(GLuint index);
+    static void vertexAttribPointer(GLuint index,
+                                    GLint size,
+                                    GLenum type,
+                                    GLboolean normalized,
+                                    GLsizei stride,
+                                    const void* pointer);
+    static void vertexAttribDivisor(GLuint index, GLuint divisor);
+
+    // Textures and framebuffers
+    static void genTextures(GLsizei n, GLuint* textures);
+    static void deleteTextures(GLsizei n, const GLuint* textures);
+    static void activeTexture(GLenum texture);
+    static void texImage2D(GLenum target,
+                           GLint level,
+                           GLint internalFormat,
+                           GLsizei width,
+                           GLsizei height,
+                           GLint border,
+                           GLenum format,
+                           GLenum type,
+                           const void* pixels);
+    static void texParameteri(GLenum target, GLenum name, GLint param);
+    static void texBuffer(GLenum target, GLenum internalFormat, GLuint buffer);
+    static void generateMipmap(GLenum target);
+    static void pixelStorei(GLenum name, GLint param);
+    static void genFramebuffers(GLsizei n, GLuint* framebuffers);
+    static void deleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+    static void framebufferTexture2D(GLenum target,
+                                     GLenum attachment,
+                                     GLenum texTarget,
+                                     GLuint texture,
+                                     GLint level);
+    static GLenum checkFramebufferStatus(GLenum target);
+
+    // Fixed state
+    static void enable(GLenum cap);
+    static void disable(GLenum cap);
+    static void depthMask(GLboolean flag);
+    static void depthFunc(GLenum func);
+    static void depthRange(GLclampd zNear, GLclampd zFar);
+    static void blendFunc(GLenum sFactor, GLenum dFactor);
+    static void blendFuncSeparate(GLenum sFactor,
+                                  GLenum dFactor,
+                                  GLenum sFactorAlpha,
+                                  GLenum dFactorAlpha);
+    static void cullFace(GLenum mode);
+    static void frontFace(GLenum mode);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void clear(GLbitfield mask);
+    static void clearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+    static void clearDepth(GLclampd depth);
+    static void clearBufferfv(GLenum buffer, GLint drawBuffer, const GLfloat* value);
+
+    // Shaders and programs
+    static GLuint createShader(GLenum type);
+    static void deleteShader(GLuint shader);
+    static void shaderSource(GLuint shader,
+                             GLsizei count,
+                             const GLchar* const* strings,
+                             const GLint* lengths);
+    static void compileShader(GLuint shader);
+    static void getShaderiv(GLuint shader, GLenum name, GLint* params);
+    static void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* log);
+    static GLuint createProgram();
+    static void deleteProgram(GLuint program);
+    static void attachShader(GLuint program, GLuint shader);
+    static void linkProgram(GLuint program);
+    static void getProgramiv(GLuint program, GLenum name, GLint* params);
+    static void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* log);
+    static void getActiveUniform(GLuint program,
+                                 GLuint index,
+                                 GLsizei bufSize,
+                                 GLsizei* length,
+                                 GLint* size,
+                                 GLenum* type,
+                                 GLchar* name);
+    static void getActiveAttrib(GLuint program,
+                                GLuint index,
+                                GLsizei bufSize,
+                                GLsizei* length,
+                                GLint* size,
+                                GLenum* type,
+                                GLchar* name);
+    static GLint getUniformLocation(GLuint program, const GLchar* name);
+    static GLint getAttribLocation(GLuint program, const GLchar* name);
+    static GLuint getUniformBlockIndex(GLuint program, const GLchar* blockName);
+
+    // Sync and queries
+    static GLsync fenceSync(GLenum condition, GLbitfield flags);
+    static GLenum clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+    static void deleteSync(GLsync sync);
+    static void finish();
+    static GLenum getError();
+    static void getIntegerv(GLenum name, GLint* data);
+    static const GLubyte* getString(GLenum name);
+    static const GLubyte* getStringi(GLenum name, GLuint index);
+    // GLEW_ARB_buffer_storage, Record maps buffers from host memory so it has it
+    static bool hasBufferStorage();
+    static void readPixels(GLint x,
+                           GLint y,
+                           GLsizei width,
+                           GLsizei height,
+                           GLenum format,
+                           GLenum type,
+                           void* pixels);
+
+private:
+    GLShim() {} // Static only.
+};
+
+// glshim.cpp calls the real entry points
+#if (GL_SHIM) && !defined(GL_SHIM_IMPLEMENTATION)
+
+// clang-format off
+
+#undef glDrawArrays
+#undef glDrawArraysInstanced
+#define glDrawArrays                GLShim::drawArrays
+#define glDrawArraysInstanced       GLShim::drawArraysInstanced
+
+#undef glBindBuffer
+#undef glBindBufferBase
+#undef glBindVertexArray
+#undef glBindTexture
+#undef glBindFramebuffer
+#undef glUseProgram
+#define glBindBuffer                GLShim::bindBuffer
+#define glBindBufferBase            GLShim::bindBufferBase
+#define glBindVertexArray           GLShim::bindVertexArray
+#define glBindTexture               GLShim::bindTexture
+#define glBindFramebuffer           GLShim::bindFramebuffer
+#define glUseProgram                GLShim::useProgram
+
+#undef glUniform1i
+#undef glUniform1f
+#undef glUniform1iv
+#undef glUniform2fv
+#undef glUniform3fv
+#undef glUniform4fv
+#undef glUniformMatrix4fv
+#undef glUniformBlockBinding
+#define glUniform1i                 GLShim::uniform1i
+#define glUniform1f                 GLShim::uniform1f
+#define glUniform1iv                GLShim::uniform1iv
+#define glUniform2fv                GLShim::uniform2fv
+#define glUniform3fv                GLShim::uniform3fv
+#define glUniform4fv                GLShim::uniform4fv
+#define glUniformMatrix4fv          GLShim::uniformMatrix4fv
+#define glUniformBlockBinding       GLShim::uniformBlockBinding
+
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glBufferData
+#undef glBufferSubData
+#undef glBufferStorage
+#undef glMapBufferRange
+#undef glUnmapBuffer
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glEnableVertexAttribArray
+#undef glVertexAttribPointer
+#undef glVertexAttribDivisor
+#define glGenBuffers                GLShim::genBuffers
+#define glDeleteBuffers             GLShim::deleteBuffers
+#define glBufferData                GLShim::bufferData
+#define glBufferSubData             GLShim::bufferSubData
+#define glBufferStorage             GLShim::bufferStorage
+#define glMapBufferRange            GLShim::mapBufferRange
+#define glUnmapBuffer               GLShim::unmapBuffer
+#define glGenVertexArrays           GLShim::genVertexArrays
+#define glDeleteVertexArrays        GLShim::deleteVertexArrays
+#define glEnableVertexAttribArray   GLShim::enableVertexAttribArray
+#define glVertexAttribPointer       GLShim::vertexAttribPointer
+#define glVertexAttribDivisor       GLShim::vertexAttribDivisor
+
+#undef glGenTextures
+#undef glDeleteTextures
+#undef glActiveTexture
+#undef glTexImage2D
+#undef glTexParameteri
+#undef glTexBuffer
+#undef glGenerateMipmap
+#undef glPixelStorei
+#undef glGenFramebuffers
+#undef glDeleteFramebuffers
+#undef glFramebufferTexture2D
+#undef glCheckFramebufferStatus
+#define glGenTextures               GLShim::genTextures
+#define glDeleteTextures            GLShim::deleteTextures
+#define glActiveTexture             GLShim::activeTexture
+#define glTexImage2D                GLShim::texImage2D
+#define glTexParameteri             GLShim::texParameteri
+#define glTexBuffer                 GLShim::texBuffer
+#define glGenerateMipmap            GLShim::generateMipmap
+#define glPixelStorei               GLShim::pixelStorei
+#define glGenFramebuffers           GLShim::genFramebuffers
+#define glDeleteFramebuffers        GLShim::deleteFramebuffers
+#define glFramebufferTexture2D      GLShim::framebufferTexture2D
+#define glCheckFramebufferStatus    GLShim::checkFramebufferStatus
+
+#undef glEnable
+#undef glDisable
+#undef glDepthMask
+#undef glDepthFunc
+#undef glDepthRange
+#undef glBlendFunc
+#undef glBlendFuncSeparate
+#undef glCullFace
+#undef glFrontFace
+#undef glViewport
+#undef glClear
+#undef glClearColor
+#undef glClearDepth
+#undef glClearBufferfv
+#define glEnable                    GLShim::enable
+#define glDisable                   GLShim::disable
+#define glDepthMask                 GLShim::depthMask
+#define glDepthFunc                 GLShim::depthFunc
+#define glDepthRange                GLShim::depthRange
+#define glBlendFunc                 GLShim::blendFunc
+#define glBlendFuncSeparate         GLShim::blendFuncSeparate
+#define glCullFace                  GLShim::cullFace
+#define glFrontFace                 GLShim::frontFace
+#define glViewport                  GLShim::viewport
+#define glClear                     GLShim::clear
+#define glClearColor                GLShim::clearColor
+#define glClearDepth                GLShim::clearDepth
+#define glClearBufferfv             GLShim::clearBufferfv
+
+#undef glCreateShader
+#undef glDeleteShader
+#undef glShaderSource
+#undef glCompileShader
+#undef glGetShaderiv
+#undef glGetShaderInfoLog
+#undef glCreateProgram
+#undef glDeleteProgram
+#undef glAttachShader
+#undef glLinkProgram
+#undef glGetProgramiv
+#undef glGetProgramInfoLog
+#undef glGetActiveUniform
+#undef glGetActiveAttrib
+#undef glGetUniformLocation
+#undef glGetAttribLocation
+#undef glGetUniformBlockIndex
+#define glCreateShader              GLShim::createShader
+#define glDeleteShader              GLShim::deleteShader
+#define glShaderSource              GLShim::shaderSource
+#define glCompileShader             GLShim::compileShader
+#define glGetShaderiv               GLShim::getShaderiv
+#define glGetShaderInfoLog          GLShim::getShaderInfoLog
+#define glCreateProgram             GLShim::createProgram
+#define glDeleteProgram             GLShim::deleteProgram
+#define glAttachShader              GLShim::attachShader
+#define glLinkProgram               GLShim::linkProgram
+#define glGetProgramiv              GLShim::getProgramiv
+#define glGetProgramInfoLog         GLShim::getProgramInfoLog
+#define glGetActiveUniform          GLShim::getActiveUniform
+#define glGetActiveAttrib           GLShim::getActiveAttrib
+#define glGetUniformLocation        GLShim::getUniformLocation
+#define glGetAttribLocation         GLShim::getAttribLocation
+#define glGetUniformBlockIndex      GLShim::getUniformBlockIndex
+
+#undef glFenceSync
+#undef glClientWaitSync
+#undef glDeleteSync
+#undef glFinish
+#undef glGetError
+#undef glGetIntegerv
+#undef glGetString
+#undef glGetStringi
+#undef glReadPixels
+#define glFenceSync                 GLShim::fenceSync
+#define glClientWaitSync            GLShim::clientWaitSync
+#define glDeleteSync                GLShim::deleteSync
+#define glFinish                    GLShim::finish
+#define glGetError                  GLShim::getError
+#define glGetIntegerv               GLShim::getIntegerv
+#define glGetString                 GLShim::getString
+#define glGetStringi                GLShim::getStringi
+#define glReadPixels                GLShim::readPixels
+
+#undef GLEW_ARB_buffer_storage
+#define GLEW_ARB_buffer_storage     GLShim::hasBufferStorage()
+
+// clang-format on
+
+#endif
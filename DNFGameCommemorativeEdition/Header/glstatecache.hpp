@@ -0,0 +1,51 @@
+#pragma once
+
+#include "glshim.hpp"
+
+/*
+ * Thin shadow of the fixed GL state the renderer touches every draw (blend, depth mask,
+ * blend/depth func, current program, 2D and buffer texture per unit).
+ *
+ * Calls that would set a value GL already has are dropped. State starts unknown, so the
+ * first call for each piece always reaches GL. Any code that changes one of these states
+ * must go through here, otherwise the shadow copy goes stale.
+ */
+class GLStateCache
+{
+public:
+    struct Stats
+    {
+        unsigned int issued {0};
+        unsigned int elided {0};
+    };
+
+    static void enable(GLenum cap);
+    static void disable(GLenum cap);
+    static void depthMask(GLboolean flag);
+    static void depthFunc(GLenum func);
+    static void blendFunc(GLenum sFactor, GLenum dFactor);
+    // While on, blendFunc keeps the destination alpha as coverage (ONE, ONE_MINUS_SRC_ALPHA),
+    // so offscreen targets end up holding premultiplied color
+    static void setPremultipliedTarget(bool premultiplied);
+    static void useProgram(GLuint program);
+    // Unit 0, sampler2D in the shaders
+    static void bindTexture2D(GLuint texture);
+    // unit must be below maxTextureUnits
+    static void bindTexture2D(GLuint unit, GLuint texture);
+    // samplerBuffer in the shaders, unit must be below maxTextureUnits
+    static void bindTextureBuffer(GLuint unit, GLuint texture);
+
+    static constexpr GLuint maxTextureUnits {16};
+
+    // GL may reuse deleted names, drop them from the shadow copy
+    static void onProgramDeleted(GLuint program);
+    static void onTextureDeleted(GLuint texture);
+
+    // Per frame counters
+    static void beginFrame();
+    static const Stats& getStats();
+    static void printStats();
+
+private:
+    GLStateCache() {} // Static only.
+};
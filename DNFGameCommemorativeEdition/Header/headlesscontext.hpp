@@ -0,0 +1,40 @@
+#pragma once
+
+// Create headless contexts through EGL, define HEADLESS_EGL=1 in the project where libEGL is
+// there to link (the Linux CMake build does it when it finds EGL)
+#ifndef HEADLESS_EGL
+#define HEADLESS_EGL 0
+#endif
+
+/*
+ * HeadlessContext
+ *
+ * OpenGL 3.3 core context on an offscreen pbuffer, made through EGL without any window
+ * system. The display comes from EGL_MESA_platform_surfaceless when the EGL library has it,
+ * so on Mesa (llvmpipe) it runs on a box with no X11, no Wayland and no GPU. Otherwise it
+ * falls back to the default display, which may need one.
+ *
+ * The pbuffer is the default framebuffer while the context is current, glReadPixels reads
+ * it like a window's back buffer.
+ */
+class HeadlessContext
+{
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Create the context and make it current, false with a message on stderr on failure
+    bool create(int width, int height);
+    void destroy();
+
+    void swapBuffers();
+
+private:
+    // EGLDisplay, EGLSurface and EGLContext, kept opaque so the EGL headers stay in the .cpp
+    void* m_display;
+    void* m_surface;
+    void* m_context;
+};
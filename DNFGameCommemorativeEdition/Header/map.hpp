@@ -8,6 +8,9 @@
 #include <glm.hpp>
 
 class FloorObj;
+class ParallaxLayer;
+class StaticLayer;
+class TileMap;
 
 /*
  * Layer Zero
@@ -22,6 +25,12 @@ public:
     void initSceneOneMap();
     void initSceneTwoMap();
 
+    // Keep the background layers in front of the camera, camera x in world space
+    void scrollBackground(GLfloat cameraX);
+
+    // Cached floor and layer one floor objs, nullptr when the cache is off
+    StaticLayer* getStaticLayer();
+
     // Map boundary to limit the player and monster movements
     glm::vec4 getMapBoundary();
 
@@ -32,6 +41,9 @@ public:
     const std::vector<std::pair<FloorObj*, glm::vec2>>& getFloorReorderObjs();
 
 protected:
+    void initBackgroundLayers(const std::string& name);
+    void addStaticContent(TileMap* tileMap, const std::string& name);
+
     ShaderProgram* m_shader;
 
     NPC* m_npc;
@@ -47,6 +59,9 @@ protected:
     float m_map_top_offset;
     float m_map_right_offset;
 
+    std::vector<ParallaxLayer*> m_background_layers;
+    StaticLayer* m_static_layer;
+
     // Use to detect collision and depth layer
     // Only layer two need to reorder depending on -y.
     // x, y -> x, y, x,y at bottom - left corner
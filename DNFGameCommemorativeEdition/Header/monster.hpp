@@ -2,18 +2,16 @@
 
 #include "geometrynode.hpp"
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "constant.hpp"
 
-#include "json.hpp"
+#include "animationcliplibrary.hpp"
 
 #include <irrKlang.h>
 #include <glm.hpp>
 
 #include <vector>
 
-using json = nlohmann::json;
-
 /*
  * Layer One
  */
@@ -31,7 +29,10 @@ public:
     // Implement virtual function from base class
     // For monster, translate will not trigger walk mode
     // but, move monster will.
-    void draw() override;
+    bool submitToCharacterBatch(CharacterBatch& characterBatch) override;
+    void submitShadow(ShadowPass& shadowPass) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
     const glm::mat4& getTransform() override;
     void translate(const glm::vec3& amount) override;
 
@@ -58,9 +59,8 @@ public:
     // Movement sign
     glm::vec2 getMonsterMovementAmount();
 
-    // Update shadow shader matrix uniforms
-    void updateShadowShaderModelMat(const glm::mat4& nodeTrans);
-    void updateShadowShaderPVMat(const glm::mat4& pTrans, const glm::mat4& vTrans);
+    // Shadow model matrix for a sprite drawn at nodeTrans
+    glm::mat4 getShadowModelMat(const glm::mat4& nodeTrans) const;
 
     // Flip the direction of the sprite
     void flipSprite();
@@ -69,6 +69,10 @@ public:
         return m_monster_sprite_facing_left_dir;
     }
 
+    // Play the death clip through and mark the monster ToBeDeleted after its last frame.
+    // Called every frame whether or not the monster is drawn.
+    void updateKilled();
+
     // If the monster is attacking or killed, then do not handle movement.
     bool lockForMovement();
 
@@ -88,32 +92,12 @@ public:
         const glm::vec3& trans);
 
 private:
-    void afterDraw();
-    void updateTexCoord();
+    void updateCurrentFrame();
     void updateFrame();
+    const AnimationClip* getModeClip(MonsterMode mode);
 
     ShaderProgram* m_shader;
 
-    // Uniform location for PVM matrix for shadow shader.
-    // Shadow is created by shear transformation and assign black/alpha value
-    // in fragement shader
-    GLint m_shadow_p_uni;
-    GLint m_shadow_v_uni;
-    GLint m_shadow_m_uni;
-    ShaderProgram m_shadow_shader;
-
-    // Uniforms and Attrib
-    GLuint m_be_hit_id;
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // Monster Vertex Array Object
-    GLuint m_monster_vao;
-    // Monster Vertex Buffer Object
-    GLuint m_monster_vbo;
-    // Monster Texture Vertex Buffer Object
-    GLuint m_monster_tex_vbo;
-
     GLfloat m_monster_width;
     GLfloat m_monster_height;
 
@@ -122,35 +106,25 @@ private:
     bool m_monster_sprite_facing_left_dir;
     MonsterMode m_monster_mode;
 
-    // Stand
-    json m_monster_stand_json_parser;
-    unsigned int m_number_of_stand_frames;
+    // Clips are shared by all monsters, only the playback is per monster
+    std::shared_ptr<const AnimationClip> m_stand_clip;
     float m_stand_animation_move_speed;
-    std::string m_current_stand_frame;
-    Texture m_stand_textures_sheet;
 
-    // Killed
-    json m_monster_killed_json_parser;
-    unsigned int m_number_of_killed_frames;
+    std::shared_ptr<const AnimationClip> m_killed_clip;
     float m_killed_animation_move_speed;
-    std::string m_current_killed_frame;
-    Texture m_killed_textures_sheet;
 
-    // Walk
-    json m_monster_walk_json_parser;
-    unsigned int m_number_of_walk_frames;
+    std::shared_ptr<const AnimationClip> m_walk_clip;
     float m_walk_animation_move_speed;
-    std::string m_current_walk_frame;
-    Texture m_walk_textures_sheet;
+
+    AnimationPlayback m_playback;
 
     // Override getTransform()
     // Due to a mistake for not separating the monster and the weapon,
-    // we need to keep track of the scale of the frame texture geo change and m_trans together
-    float m_current_scale_x;
-    float m_current_scale_y;
+    // we need to keep track of the frame texture geo change and m_trans together
     glm::mat4 m_return_trans;
 
-    float m_animation_cursor;
+    // Current frame, getTransform() places its quad and the shadow samples the same region
+    AnimationClip::Frame m_frame;
 
     // Move and collision
     float m_monster_dx;
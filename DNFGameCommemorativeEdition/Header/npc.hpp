@@ -2,10 +2,10 @@
 
 #include "geometrynode.hpp"
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "constant.hpp"
 
-#include "json.hpp"
+#include "animationcliplibrary.hpp"
 
 #include <glm.hpp>
 
@@ -15,8 +15,6 @@
  * We are only going to have one NPC here, no extendibility is considered here.
  */
 
-using json = nlohmann::json;
-
 /*
  * Layer One
  */
@@ -27,8 +25,12 @@ public:
     ~NPC() {}
 
     // Implement virtual function from base class
-    void draw() override;
+    bool submitToCharacterBatch(CharacterBatch& characterBatch) override;
+    void submitShadow(ShadowPass& shadowPass) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
     void translate(const glm::vec3& amount) override;
+    const glm::mat4& getTransform() override;
 
     // x, y -> x, y, x,y at bottom - left corner
     // z -> width
@@ -50,40 +52,19 @@ public:
         return m_npc_dy;
     }
 
-    // Update shadow shader matrix uniforms
-    void updateShadowShaderModelMat(const glm::mat4& nodeTrans);
-    void updateShadowShaderPVMat(const glm::mat4& pTrans, const glm::mat4& vTrans);
+    // Shadow model matrix for a sprite drawn at nodeTrans
+    glm::mat4 getShadowModelMat(const glm::mat4& nodeTrans) const;
 
     // If mouse is on top of the NPC.
     bool checkOnTop();
     bool checkOnTop(const glm::vec2& mousePos);
 
 private:
-    void updateTexCoord();
+    void updateCurrentFrame();
     void updateFrame();
 
     ShaderProgram* m_shader;
 
-    // Uniform location for PVM matrix for shadow shader.
-    // Shadow is created by shear transformation and assign black/alpha value
-    // in fragement shader
-    GLint m_shadow_p_uni;
-    GLint m_shadow_v_uni;
-    GLint m_shadow_m_uni;
-    ShaderProgram m_shadow_shader;
-
-    // Uniforms and Attrib
-    GLuint m_show_outline_id;
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // NPC Vertex Array Object
-    GLuint m_npc_vao;
-    // NPC Vertex Buffer Object
-    GLuint m_npc_vbo;
-    // NPC Texture Vertex Buffer Object
-    GLuint m_npc_tex_vbo;
-
     GLfloat m_npc_width;
     GLfloat m_npc_height;
 
@@ -93,13 +74,13 @@ private:
 
     // Animation
     // Animation speed here is divided by 1000
-    json m_npc_animation_json_parser;
-    unsigned int m_number_of_frames;
+    std::shared_ptr<const AnimationClip> m_clip;
     float m_animation_speed;
-    std::string m_current_frame;
-    Texture m_textures_sheet;
+    AnimationPlayback m_playback;
 
-    float m_animation_cursor;
+    // Current frame, getTransform() places its quad and the shadow samples the same region
+    AnimationClip::Frame m_frame;
+    glm::mat4 m_return_trans;
 
     // Hover outline
     bool m_npc_show_outline;
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+#include "texturecache.hpp"
+#include "geometrynode.hpp"
+
+#include <glm.hpp>
+
+/*
+ * Layer zero
+ *
+ * One window wide quad that stays in front of the camera and scrolls its art through
+ * the uvs instead, so a layer costs a single quad however wide the map is. The art is
+ * loaded on its own (not in the atlas) with GL_REPEAT, u runs past 1 to wrap it.
+ *
+ * A scroll ratio of 1 moves the art with the floor, smaller ratios fall behind.
+ */
+class ParallaxLayer : public GeometryNode
+{
+public:
+    enum class LayerType { Far, Mid };
+
+    ParallaxLayer(const std::string& name,
+                  ShaderProgram* shader,
+                  GLfloat width,
+                  GLfloat height,
+                  GLfloat bottom,
+                  LayerType layerType);
+    ~ParallaxLayer() {}
+
+    // Camera x in world space
+    void scroll(GLfloat cameraX);
+
+    bool submitToBatch(SpriteBatch& spriteBatch) override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Sprite, m_texture->getTextureId()};
+    }
+
+private:
+    ShaderProgram* m_shader;
+
+    std::shared_ptr<Texture> m_texture;
+
+    GLfloat m_plane_width;
+    GLfloat m_plane_height;
+    GLfloat m_scroll_ratio;
+
+    // Quad transform at camera x 0
+    glm::mat4 m_base_trans;
+    glm::vec4 m_uv_rect;
+};
@@ -2,18 +2,16 @@
 
 #include "geometrynode.hpp"
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "constant.hpp"
 
-#include "json.hpp"
+#include "animationcliplibrary.hpp"
 
 #include <irrKlang.h>
 #include <glm.hpp>
 
 #include <vector>
 
-using json = nlohmann::json;
-
 class PlayerSkillEffect;
 
 /*
@@ -44,7 +42,10 @@ public:
     PlayerMode getPlayerMode();
 
     // Implement virtual function from base class
-    void draw() override;
+    bool submitToCharacterBatch(CharacterBatch& characterBatch) override;
+    void submitShadow(ShadowPass& shadowPass) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
     void translate(const glm::vec3& amount) override;
     const glm::mat4& getTransform() override;
 
@@ -70,9 +71,8 @@ public:
     // Movement sign
     glm::vec2 getPlayerMovementAmount();
 
-    // Update shadow shader matrix uniforms
-    void updateShadowShaderModelMat(const glm::mat4& nodeTrans);
-    void updateShadowShaderPVMat(const glm::mat4& pTrans, const glm::mat4& vTrans);
+    // Shadow model matrix for a sprite drawn at nodeTrans
+    glm::mat4 getShadowModelMat(const glm::mat4& nodeTrans) const;
 
     // Flip the direction of the sprite
     void flipSprite();
@@ -85,29 +85,12 @@ public:
 
 private:
     void afterDraw();
-    void updateTexCoord();
+    void updateCurrentFrame();
     void updateFrame();
+    const AnimationClip* getCurrentClip();
 
     ShaderProgram* m_shader;
 
-    // Uniform location for PVM matrix for shadow shader.
-    // Shadow is created by shear transformation and assign black/alpha value
-    // in fragement shader
-    GLint m_shadow_p_uni;
-    GLint m_shadow_v_uni;
-    GLint m_shadow_m_uni;
-    ShaderProgram m_shadow_shader;
-
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
-
-    // Player Vertex Array Object
-    GLuint m_player_vao;
-    // Player Vertex Buffer Object
-    GLuint m_player_vbo;
-    // Player Texture Vertex Buffer Object
-    GLuint m_player_tex_vbo;
-
     GLfloat m_player_width;
     GLfloat m_player_height;
 
@@ -118,40 +101,41 @@ private:
     PlayerMoveDir m_player_move_dir;
 
     // Stand
-    json m_play_stand_json_parser;
+    std::shared_ptr<const AnimationClip> m_stand_clip;
     unsigned int m_number_of_stand_frames;
     float m_stand_animation_move_speed;
-    std::string m_current_stand_frame;
-    Texture m_stand_textures_sheet;
+    unsigned int m_current_stand_frame;
 
     // Walk
-    json m_play_walk_json_parser;
+    std::shared_ptr<const AnimationClip> m_walk_clip;
     unsigned int m_number_of_walk_frames;
     float m_walk_animation_move_speed;
-    std::string m_current_walk_frame;
-    Texture m_walk_textures_sheet;
+    unsigned int m_current_walk_frame;
 
     // Basic Attack
-    json m_play_basic_attack_json_parser;
+    std::shared_ptr<const AnimationClip> m_basic_attack_clip;
     unsigned int m_number_of_basic_attack_frames;
     float m_basic_attack_animation_move_speed;
-    std::string m_current_basic_attack_frame;
-    Texture m_basic_attack_textures_sheet;
+    unsigned int m_current_basic_attack_frame;
 
     // Skill
-    json m_play_skill_json_parser;
+    std::shared_ptr<const AnimationClip> m_skill_clip;
     unsigned int m_number_of_skill_frames;
     float m_skill_animation_move_speed;
-    std::string m_current_skill_frame;
-    Texture m_skill_textures_sheet;
+    unsigned int m_current_skill_frame;
 
     // Override getTransform()
     // Due to a mistake for not separating the player and the weapon,
     // we need to keep track of the scale of the frame texture geo change and m_trans together
+    // The scale is the untrimmed frame size
     float m_current_scale_x;
     float m_current_scale_y;
     glm::mat4 m_return_trans;
 
+    // Current frame, getTransform() places its quad and the shadow samples the same region
+    AnimationClip::Frame m_frame;
+    unsigned int m_frame_index;
+
     float m_animation_cursor;
 
     // Move and collision
@@ -1,15 +1,13 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
-#include "json.hpp"
+#include "animationcliplibrary.hpp"
 
 #include <glm.hpp>
 
-using json = nlohmann::json;
-
 class Player;
 
 /*
@@ -18,13 +16,16 @@ class Player;
 class PlayerSkillEffect : public GeometryNode
 {
 public:
-    PlayerSkillEffect(ShaderProgram* shader, ShaderProgram* shadowShader, Player* player);
+    PlayerSkillEffect(ShaderProgram* shader, Player* player);
     ~PlayerSkillEffect() {}
 
-    void draw() override;
+    bool submitToCharacterBatch(CharacterBatch& characterBatch) override;
+    void submitShadow(ShadowPass& shadowPass) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
     const glm::mat4& getTransform() override;
 
-    void useFrame(std::string frameNumber, bool flip);
+    void useFrame(unsigned int frameIndex, bool flip);
 
     void clearMovement();
 
@@ -32,13 +33,9 @@ public:
     static const float skill_shift_eighteen;
 
 private:
-    void updateTexCoord();
+    void updateCurrentFrame();
 
     ShaderProgram* m_shader;
-    ShaderProgram* m_shadow_shader;
-
-    GLuint m_position_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
 
     GLfloat m_player_skill_effect_dx;
     GLfloat m_player_skill_effect_dy;
@@ -47,24 +44,16 @@ private:
     bool m_player_sprite_facing_left_dir;
 
     // Frame
-    json m_play_skill_effect_json_parser;
-    std::string m_current_play_skill_effect_frame;
-    unsigned int m_number_of_skill_effect_frames;
-    Texture m_textures_sheet;
+    std::shared_ptr<const AnimationClip> m_skill_effect_clip;
+    unsigned int m_current_play_skill_effect_frame;
 
     // Override getTransform()
     // Due to a mistake for not separating the player and the weapon,
-    // we need to keep track of the scale of the frame texture geo change and m_trans together
-    float m_current_scale_x;
-    float m_current_scale_y;
+    // we need to keep track of the frame texture geo change and m_trans together
     glm::mat4 m_return_trans;
 
-    // PlayerSkillEffect Vertex Array Object
-    GLuint m_player_skill_effect_vao;
-    // PlayerSkillEffect Vertex Buffer Object
-    GLuint m_player_skill_effect_vbo;
-    // PlayerSkillEffect Texture Vertex Buffer Object
-    GLuint m_player_skill_effect_tex_vbo;
+    // Current frame, getTransform() places its quad and the shadow samples the same region
+    AnimationClip::Frame m_frame;
 
     Player* m_player;
 };
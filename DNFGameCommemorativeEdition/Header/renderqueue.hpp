@@ -0,0 +1,93 @@
+#pragma once
+
+#include "scenenode.hpp"
+
+#include <glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * Per frame list of render commands, filled by the scene traversal in painter's order and
+ * radix sorted before anything is drawn.
+ *
+ * The 64 bit key is, from the top bit down:
+ *   level    16 bits  painter level, see below
+ *   program   8 bits  RenderProgram
+ *   texture  16 bits  GL texture id
+ *   sequence 24 bits  traversal order
+ *
+ * A command is put one level above the highest earlier command its bounds overlap, so
+ * whatever it is drawn over still goes first, and commands on one level never overlap.
+ * Inside a level commands are grouped by program and texture. The sequence keeps equal
+ * states (the y sorted characters and floor objects included) in traversal order.
+ *
+ * Bounds must never under-report what a node draws, or the node can end up on the level
+ * of something it overlaps and be reordered against it.
+ *
+ * Earlier commands are looked up through a grid over the view, so a command is only
+ * tested against the ones sharing a cell with it.
+ */
+class RenderQueue
+{
+public:
+    struct Command
+    {
+        uint64_t key;
+        // nullptr for the shadow pass
+        SceneNode* node;
+    };
+
+    struct Stats
+    {
+        unsigned int commands {0};
+        unsigned int levels {0};
+        // Program or texture changes between consecutive commands, before and after sorting
+        unsigned int stateChangesUnsorted {0};
+        unsigned int stateChangesSorted {0};
+    };
+
+    void clear();
+
+    // In painter's order, bounds are (left, bottom, right, top) in world space
+    void push(SceneNode* node, const glm::vec4& bounds, const SceneNode::RenderState& state);
+
+    // Shadows are one command drawn under every character, bounds cover all of them
+    void pushShadowPass(const glm::vec4& bounds);
+
+    // viewRect is (left, bottom, right, top) in world space, what every command overlaps
+    void sort(const glm::vec4& viewRect);
+
+    const std::vector<Command>& getCommands() const;
+
+    void resetStats();
+    const Stats& getStats() const;
+
+private:
+    struct Entry
+    {
+        SceneNode* node;
+        glm::vec4 bounds;
+        SceneNode::RenderState state;
+    };
+
+    // Returns the number of levels
+    unsigned int assignLevels(const glm::vec4& viewRect);
+    // (first x, first y, last x, last y) of the grid cells bounds fall into
+    static glm::ivec4 getGridCells(const glm::vec4& bounds, const glm::vec4& viewRect);
+
+    static unsigned int countStateChanges(const std::vector<Command>& commands);
+
+    std::vector<Entry> m_entries;
+    std::vector<unsigned int> m_levels;
+
+    // Earlier entries per grid cell, and the highest level + 1 among them
+    std::vector<std::vector<unsigned int>> m_grid_entries;
+    std::vector<unsigned int> m_grid_tops;
+
+    std::vector<Command> m_commands;
+    // Radix sort ping pong buffer
+    std::vector<Command> m_scratch;
+
+    Stats m_stats;
+};
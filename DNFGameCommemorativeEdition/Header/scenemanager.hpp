@@ -10,8 +10,14 @@
 #include "scenetwo.hpp"
 #include "dialogscenenode.hpp"
 #include "starparticlesgenerator.hpp"
+#include "spritebatch.hpp"
+#include "characterbatch.hpp"
+#include "shadowpass.hpp"
+#include "renderqueue.hpp"
+#include "staticlayer.hpp"
+#include "camerauniformbuffer.hpp"
 
-#include "GL/glew.h"
+#include "glshim.hpp"
 
 #include <irrKlang.h>
 
@@ -32,13 +38,17 @@ public:
     SceneManager(ShaderProgram* shader,
                  GLfloat frameBufferWidth,
                  GLfloat frameBufferHeight,
-                 GLFWwindow* window);
+                 GLFWwindow* window,
+                 CameraUniformBuffer* cameraUbo);
     ~SceneManager();
 
     // Scenes
     void constructScenes();
     void drawCurrentScene();
 
+    // Camera rectangle (left, bottom, right, top) in world space, nodes outside are culled
+    void setViewRect(const glm::vec4& viewRect);
+
     // Player
     Player* getPlayer();
     void movePlayer(Player::PlayerMoveDir moveDir);
@@ -63,20 +73,58 @@ public:
     // Dialog
     void moveDialog(float dx);
 
+    // Background, camera x in world space
+    void scrollBackground(float cameraX);
+
+    // Per frame traversal counters, model matrix pushes are bounded by visited nodes.
+    // Geometry nodes are either visible or culled.
+    struct TraversalStats
+    {
+        unsigned int visitedNodes {0};
+        unsigned int modelMatPushes {0};
+        unsigned int visibleNodes {0};
+        unsigned int culledNodes {0};
+    };
+
+    const TraversalStats& getTraversalStats() const;
+    void printTraversalStats() const;
+
     // Get current scene state
     CurrentSceneState getCurrentSceneState()
     {
         return m_current_scene_state;
     }
 
+    // Jump to a scene, a Prep state prepares it on the next draw (tests start in scene two)
+    void setCurrentSceneState(CurrentSceneState state)
+    {
+        m_current_scene_state = state;
+    }
+
 private:
     void drawSceneZero();
     void drawSceneOne();
     void drawSceneTwo();
     void reorderCurrentSceneLayerNode();
-    void renderSceneGraphNodes(SceneNode* node, glm::mat4 modelMat);
+    void renderSceneGraph(SceneNode* root);
+    void updateStaticLayer(StaticLayer* staticLayer);
+    void accumulateWorldBounds(SceneNode* node, glm::vec4& bounds);
+    void updateWorldTransforms(SceneNode* node, const glm::mat4& modelMat);
+    void queueSceneGraphNodes(SceneNode* node);
+    void runRenderQueue();
+    void flushCharacterBatch();
 
     ShaderProgram* m_shader;
+    ShaderProgram::UniformId m_model_uni_id;
+    TraversalStats m_traversal_stats;
+    glm::vec4 m_view_rect;
+    std::unique_ptr<SpriteBatch> m_sprite_batch;
+    std::unique_ptr<CharacterBatch> m_character_batch;
+    std::unique_ptr<ShadowPass> m_shadow_pass;
+    std::unique_ptr<RenderQueue> m_render_queue;
+    // Union of the character bounds, the shadow pass command covers it
+    glm::vec4 m_shadow_bounds;
+    bool m_shadow_pass_queued;
     GLfloat m_frame_buffer_width;
     GLfloat m_frame_buffer_height;
 
@@ -105,4 +153,7 @@ private:
     irrklang::ISoundSource* m_scenes_bg;
 
     GLFWwindow* m_window;
+
+    // Owned by Game, the static layer pass points it at each tile and back
+    CameraUniformBuffer* m_camera_ubo;
 };
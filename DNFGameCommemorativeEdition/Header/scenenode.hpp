@@ -7,8 +7,15 @@
 #include <iostream>
 #include <functional>
 
+class SpriteBatch;
+class CharacterBatch;
+class ShadowPass;
+
 enum class NodeType { SceneNode, GeometryNode };
 
+// Program a node is drawn with, the render queue keeps equal ones together
+enum class RenderProgram { Sprite, Character, Particle };
+
 class SceneNode
 {
 public:
@@ -20,6 +27,44 @@ public:
 
     virtual void draw() {};
 
+    // Static sprites queue their quad instead of drawing, returns false if draw() is needed
+    virtual bool submitToBatch(SpriteBatch&)
+    {
+        return false;
+    }
+
+    // Animated characters queue an instance instead of drawing, returns false if draw() is needed
+    virtual bool submitToCharacterBatch(CharacterBatch&)
+    {
+        return false;
+    }
+
+    // Shadow casters queue their shadow, called for every node before anything is drawn
+    virtual void submitShadow(ShadowPass&) {}
+
+    // viewRect is (left, bottom, right, top) in world space, tested right after m_world_trans
+    // is written. Culled nodes skip submitShadow() and drawing, children are still tested.
+    virtual bool isVisible(const glm::vec4& viewRect);
+
+    // (left, bottom, right, top) in world space of everything the node draws
+    virtual glm::vec4 getWorldBounds();
+
+    // State the node is drawn with, used to sort nodes that do not overlap
+    struct RenderState
+    {
+        RenderProgram program;
+        unsigned int texture;
+    };
+
+    virtual RenderState getRenderState()
+    {
+        return {RenderProgram::Sprite, 0};
+    }
+
+    // (left, bottom, right, top) of the unit quad under trans
+    static glm::vec4 getQuadBounds(const glm::mat4& trans);
+    static bool overlaps(const glm::vec4& a, const glm::vec4& b);
+
     virtual const glm::mat4& getTransform();
     const glm::mat4& getInverse();
 
@@ -48,6 +93,10 @@ public:
     // Transformations
     glm::mat4 m_trans;
     glm::mat4 m_invtrans;
+    // Parents * m_trans, written by the scene traversal before submitShadow() and draw()
+    glm::mat4 m_world_trans;
+    // Written by the scene traversal with m_world_trans
+    bool m_culled;
 
     std::list<SceneNode*> m_children;
 
@@ -3,11 +3,12 @@
 #include "scenenode.hpp"
 #include "shaderprogram.hpp"
 
-#include "GL/glew.h"
+#include "glshim.hpp"
 
 #include <memory>
 
 class Map;
+class StaticLayer;
 class Player;
 class NPC;
 class DialogSceneNode;
@@ -59,6 +60,12 @@ public:
     // Dialog
     void moveDialog(float dx);
 
+    // Background
+    void scrollBackground(float cameraX);
+
+    // Cached static map layer, nullptr when there is none
+    StaticLayer* getStaticLayer();
+
     // Initial display, should call first.
     void prepareInitialDisplay();
 
@@ -4,11 +4,12 @@
 #include "shaderprogram.hpp"
 #include "constant.hpp"
 
-#include "GL/glew.h"
+#include "glshim.hpp"
 
 #include <memory>
 
 class Map;
+class StaticLayer;
 class Player;
 class Button;
 class Monster;
@@ -53,6 +54,13 @@ public:
 
     // Dialog and mouse processing
     void moveDialog(float dx);
+
+    // Background
+    void scrollBackground(float cameraX);
+
+    // Cached static map layer, nullptr when there is none
+    StaticLayer* getStaticLayer();
+
     Scene::SceneEvents processClick();
     bool processHover(const glm::vec2& mousePos);
 
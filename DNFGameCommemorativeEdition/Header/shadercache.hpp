@@ -0,0 +1,28 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+
+#include <memory>
+#include <string>
+
+/*
+ * Process-wide shader program registry keyed by the vertex/fragment file pair.
+ *
+ * Player, NPC and every Monster used to compile and link their own copy of the shadow
+ * shader, so spawning N monsters meant N compiles. acquire() compiles each pair once and
+ * hands out shared handles; the program is deleted once the last handle goes away.
+ *
+ * Since the program object is shared, uniforms are shared as well. Entities must upload
+ * their per-draw uniforms (M) right before drawing instead of keeping them in the program.
+ */
+class ShaderCache
+{
+public:
+    static std::shared_ptr<ShaderProgram> acquire(const std::string& vertexShaderPath,
+                                                  const std::string& fragmentShaderPath);
+
+    static unsigned int getCompiledProgramsCount();
+
+private:
+    ShaderCache() {} // Static only.
+};
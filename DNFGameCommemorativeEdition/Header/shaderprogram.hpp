@@ -4,14 +4,22 @@
 
 #pragma once
 
-#include <GL/glew.h>
+#include "glshim.hpp"
+
 #include <GLFW/glfw3.h>
 
+#include <glm.hpp>
+
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class ShaderProgram
 {
 public:
+    // Index into the active uniform table built by link()
+    typedef int UniformId;
+
     ShaderProgram();
 
     ~ShaderProgram();
@@ -38,6 +46,21 @@ public:
 
     GLint getAttribLocation(const char* attributeName) const;
 
+    UniformId getUniformId(const char* uniformName) const;
+
+    // Returns false when the program has no such active block.
+    bool bindUniformBlock(const char* blockName, GLuint bindingPoint);
+
+    // Typed uniform setters. The program must be enabled.
+    // The upload is skipped when the value equals the last one set through here,
+    // so do not mix them with raw glUniform* calls on the same uniform.
+    void set(UniformId id, GLint value);
+    void set(UniformId id, GLfloat value);
+    void set(UniformId id, const glm::vec2& value);
+    void set(UniformId id, const glm::vec3& value);
+    void set(UniformId id, const glm::vec4& value);
+    void set(UniformId id, const glm::mat4& value);
+
 private:
     struct Shader
     {
@@ -51,10 +74,23 @@ private:
     Shader fragmentShader;
     Shader geometryShader;
 
+    struct Uniform
+    {
+        GLint location;
+        GLenum type;
+        bool hasValue;
+        GLfloat value[16]; // Shadow copy of the last upload (mat4 at most)
+    };
+
     GLuint programObject;
     GLuint prevProgramObject;
     GLuint activeProgram;
 
+    // Active uniforms and attributes, resolved once after link()
+    std::vector<Uniform> uniforms;
+    std::unordered_map<std::string, UniformId> uniformIds;
+    std::unordered_map<std::string, GLint> attribLocations;
+
     void extractSourceCode(std::string& shaderSource, const std::string& filePath);
 
     void extractSourceCodeAndCompile(const Shader& shader);
@@ -67,5 +103,9 @@ private:
 
     void checkLinkStatus();
 
+    void cacheActiveUniformsAndAttribs();
+
+    bool updateShadowCopy(UniformId id, const void* data, size_t size);
+
     void deleteShaders();
 };
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Draws the shadows of every character in one pass before any character sprite.
+ *
+ * Player, NPC, monsters and the skill effect used to switch to the shadow program, draw
+ * their own sheared quad and switch back, once per entity per frame. They now queue an
+ * instance (model matrix, frame uv rect and shear) and run() binds the shadow program once
+ * and issues a single instanced draw for every sprite sheet in use.
+ *
+ * Shadows are black with a constant alpha, so the order among them does not matter.
+ */
+class ShadowPass
+{
+public:
+    struct Stats
+    {
+        unsigned int instances {0};
+        unsigned int drawCalls {0};
+    };
+
+    // (tilt, scale), the shader maps the unit quad (x, y) to (x + tilt * y, scale * y)
+    static const glm::vec2 defaultShear;
+
+    ShadowPass();
+    ~ShadowPass();
+
+    // uvRect is (u0, v0, u1, v1) of the current frame
+    void submit(const glm::mat4& modelMat,
+                GLuint textureId,
+                const glm::vec4& uvRect,
+                const glm::vec2& shear = defaultShear);
+
+    // (left, bottom, right, top) in world space of the sprite quad under spriteTrans and
+    // its sheared shadow under shadowModelMat, for casters' getWorldBounds()
+    static glm::vec4 getCasterBounds(const glm::mat4& spriteTrans,
+                                     const glm::mat4& shadowModelMat,
+                                     const glm::vec2& shear = defaultShear);
+
+    // Draw every queued shadow, returns false if there was nothing to draw.
+    // Leaves the shadow program bound.
+    bool run();
+
+    void resetStats();
+    const Stats& getStats() const;
+
+private:
+    struct Instance
+    {
+        glm::mat4 modelMat;
+        glm::vec4 uvRect;
+        glm::vec2 shear;
+        GLuint textureId;
+    };
+
+    // base is the byte offset of the first instance in the stream buffer
+    void setInstanceAttribPointers(GLintptr base);
+
+    std::shared_ptr<ShaderProgram> m_shadow_shader;
+
+    GLint m_model_attrib_pos;
+    GLint m_uv_rect_attrib_pos;
+    GLint m_shear_attrib_pos;
+
+    std::vector<Instance> m_instances;
+    // Model matrix, uv rect and shear per instance
+    std::vector<GLfloat> m_instance_data;
+
+    // ShadowPass Vertex Array Object
+    GLuint m_shadow_pass_vao;
+
+    Stats m_stats;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <vector>
+
+/*
+ * Collects the textured unit quads of static sprite nodes (background, floor objects, UI)
+ * and draws every consecutive run sharing a texture and text mode with a single glDrawArrays.
+ *
+ * Quads are transformed to world space on the CPU, so one run can span any number of
+ * nodes. A run ends when the texture or mode changes or flush() is called, which keeps the
+ * painter's order of the scene graph intact.
+ */
+class SpriteBatch
+{
+public:
+    struct Stats
+    {
+        unsigned int quads {0};
+        unsigned int drawCalls {0};
+    };
+
+    SpriteBatch(ShaderProgram* shader);
+    ~SpriteBatch();
+
+    // uvRect is (u0, v0, u1, v1) of the texture
+    void submit(const glm::mat4& modelMat,
+                GLuint textureId,
+                const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+                bool isText = false);
+
+    // Draw pending quads, needed before anything is drawn outside of the batch
+    void flush();
+
+    void resetStats();
+    const Stats& getStats() const;
+
+private:
+    // base is the byte offset of the run in the stream buffer
+    void setVertexAttribPointers(GLintptr base);
+
+    ShaderProgram* m_shader;
+    ShaderProgram::UniformId m_model_uni_id;
+    ShaderProgram::UniformId m_draw_text_uni_id;
+
+    // Pending run, x, y, z, u, v per vertex
+    std::vector<GLfloat> m_vertices;
+    GLuint m_pending_texture_id;
+    bool m_pending_is_text;
+
+    GLuint m_position_attrib_pos;
+    GLuint m_texture_coor_attrib_pos;
+
+    // SpriteBatch Vertex Array Object
+    GLuint m_sprite_batch_vao;
+
+    Stats m_stats;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Frame metadata of one TexturePacker sprite sheet.
+ *
+ * Every sheet used to go through json::parse at startup. SpriteSheetConverter writes the
+ * same data as a compact binary file next to the json (same name, .ssb), a header followed
+ * by the packed frame records, which is loaded with a single read. load() falls back to
+ * the json when the binary is missing, older than the json or does not validate.
+ *
+ * The binary is little endian and native layout, it is a build artifact and is not meant
+ * to be moved between machines.
+ */
+class SpriteSheetData
+{
+public:
+    // clang-format off
+    static constexpr std::uint32_t magic   {0x42535344}; // "DSSB"
+    static constexpr std::uint32_t version {1};
+    // clang-format on
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t frameCount;
+        // Sheet size in pixels
+        std::uint16_t sheetWidth;
+        std::uint16_t sheetHeight;
+    };
+
+    // All sizes in pixels
+    struct Frame
+    {
+        // Rect in the sheet
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint16_t w;
+        std::uint16_t h;
+        // Rect of the trimmed pixels inside the untrimmed source frame
+        std::uint16_t trimX;
+        std::uint16_t trimY;
+        std::uint16_t trimW;
+        std::uint16_t trimH;
+        // Untrimmed source frame
+        std::uint16_t sourceW;
+        std::uint16_t sourceH;
+        std::uint8_t trimmed;
+        std::uint8_t rotated;
+    };
+
+    struct Sheet
+    {
+        unsigned int width {0};
+        unsigned int height {0};
+        // Frames are keyed "0" to "n - 1" in the json
+        std::vector<Frame> frames;
+    };
+
+    // Binary when it is up to date, json otherwise
+    static Sheet load(const std::string& jsonPath);
+
+    static bool loadBinary(const std::string& binaryPath, Sheet& sheet);
+    static Sheet loadJson(const std::string& jsonPath);
+    static bool writeBinary(const std::string& binaryPath, const Sheet& sheet);
+
+    // Binary missing or older than the json
+    static bool isBinaryStale(const std::string& jsonPath);
+    static std::string getBinaryPath(const std::string& jsonPath);
+
+private:
+    SpriteSheetData() {} // Static only.
+};
+
+static_assert(sizeof(SpriteSheetData::Header) == 16, "SpriteSheetData::Header must be packed");
+static_assert(sizeof(SpriteSheetData::Frame) == 22, "SpriteSheetData::Frame must be packed");
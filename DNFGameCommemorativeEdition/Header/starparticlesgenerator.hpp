@@ -1,7 +1,7 @@
 #pragma once
 
 #include "shaderprogram.hpp"
-#include "texture.hpp"
+#include "texturecache.hpp"
 #include "geometrynode.hpp"
 
 /*
@@ -21,8 +21,19 @@ public:
     void draw() override;
     void translate(const glm::vec3& amount) override;
 
-    void updateParticleShaderPVMat(const glm::mat4& pTrans, const glm::mat4& vTrans);
-    void updateParticleShaderModelMat(const glm::mat4& nodeTrans);
+    // Particles drift out of the node quad, never culled
+    bool isVisible(const glm::vec4&) override
+    {
+        return true;
+    }
+
+    // Everything, drawn in traversal order with all other nodes
+    glm::vec4 getWorldBounds() override;
+
+    RenderState getRenderState() override
+    {
+        return {RenderProgram::Particle, m_texture->getTextureId()};
+    }
 
     void cleanMovement();
 
@@ -41,24 +52,16 @@ private:
     ShaderProgram* m_shader;
 
     // Particle shader
-    ShaderProgram m_particle_shader;
-    GLint m_particle_p_uni;
-    GLint m_particle_v_uni;
+    std::shared_ptr<ShaderProgram> m_particle_shader;
     GLint m_particle_m_uni;
 
     // Star texture
-    Texture m_texture;
+    std::shared_ptr<Texture> m_texture;
 
     // Particles Generator Vertex Array Object
     GLuint m_particles_generator_vao;
-    // Particles Generator Basic Mesh Vertex Buffer Object
-    GLuint m_particles_generator_basic_mesh_vbo;
-    // Particles Generator Position Offset Vertex Buffer Object
-    GLuint m_particles_generator_pos_offset_vbo;
 
-    GLuint m_position_attrib_pos;
     GLuint m_pos_offset_attrib_pos;
-    GLuint m_texture_coor_attrib_pos;
 
     // Move
     float m_dx;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+#include "geometrynode.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Layer zero and one
+ *
+ * Map content that does not change once the map is built (floor tiles, layer one floor
+ * objs), rendered into window wide offscreen tiles covering the whole map and drawn from
+ * there, one quad per tile in view.
+ *
+ * The content hangs under its own root, out of the scene graph. SceneManager renders it
+ * into the tiles whenever the layer is dirty, which is once per map unless invalidate()
+ * is called after the content changes.
+ *
+ * Tiles hold premultiplied color and are drawn with (ONE, ONE_MINUS_SRC_ALPHA).
+ */
+class StaticLayer : public GeometryNode
+{
+public:
+    StaticLayer(const std::string& name, ShaderProgram* shader);
+    ~StaticLayer();
+
+    // The layer takes the node over, invalidates the tiles
+    void addContent(SceneNode* node);
+    SceneNode* getContentRoot();
+
+    void invalidate();
+    void validate();
+    bool isDirty() const;
+
+    // Reallocate the tiles to cover bounds (left, bottom, right, top) in the map space,
+    // tileWidth pixels each
+    void resize(const glm::vec4& bounds, GLfloat tileWidth);
+
+    // Bind tile i as the framebuffer, cleared, with a viewport covering it.
+    // Returns the map space rect it holds.
+    glm::vec4 bindTile(size_t i);
+
+    // Keeps which tiles overlap viewRect for draw()
+    bool isVisible(const glm::vec4& viewRect) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
+    void draw() override;
+
+    unsigned int getTilesCount() const
+    {
+        return static_cast<unsigned int>(m_tiles.size());
+    }
+
+private:
+    struct Tile
+    {
+        // (left, bottom, right, top) in the map space, whole pixels
+        glm::vec4 bounds;
+        bool visible;
+
+        GLuint fbo;
+        GLuint texture;
+    };
+
+    void releaseTiles();
+    glm::vec4 getTileWorldBounds(const Tile& tile) const;
+
+    ShaderProgram* m_shader;
+    ShaderProgram::UniformId m_draw_text_uni_id;
+
+    std::unique_ptr<SceneNode> m_content_root;
+    bool m_dirty;
+
+    std::vector<Tile> m_tiles;
+
+    // One quad per tile, tile i starts at vertex i * UnitQuad::verticesCount
+    GLuint m_vao;
+    GLuint m_vbo;
+};
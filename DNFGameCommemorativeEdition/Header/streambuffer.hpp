@@ -0,0 +1,57 @@
+#pragma once
+
+#include "glshim.hpp"
+
+/*
+ * One large GL_ARRAY_BUFFER that every per frame vertex and instance upload is
+ * suballocated from (SpriteBatch, CharacterBatch, ShadowPass, particles).
+ *
+ * Each of them used to own a small buffer and orphan or glBufferSubData it on every flush.
+ * The buffer is split into regionsCount regions, one per frame in flight, and upload()
+ * hands out aligned ranges of the current frame's region. A fence is placed after each
+ * frame, the region is only written again once its fence has signaled.
+ *
+ * With ARB_buffer_storage the buffer is persistently mapped and upload() is a memcpy.
+ * Otherwise the buffer is orphaned at the start of each frame and filled with
+ * glBufferSubData at increasing offsets, so nothing drawn earlier is overwritten.
+ *
+ * Callers bind getBufferId() and point their attributes at the returned offset.
+ */
+class StreamBuffer
+{
+public:
+    // clang-format off
+    static constexpr unsigned int regionsCount {3};
+    static constexpr GLsizeiptr regionSize     {4 * 1024 * 1024};
+    static constexpr GLsizeiptr alignment      {16};
+    // clang-format on
+
+    struct Stats
+    {
+        unsigned int bytes {0};
+        unsigned int uploads {0};
+        // Times a fence was not signaled yet or a region ran out mid frame
+        unsigned int waits {0};
+    };
+
+    // Needs a current GL context
+    static void init();
+    static void release();
+
+    // Around everything drawn in a frame
+    static void beginFrame();
+    static void endFrame();
+
+    // Copy size bytes into the current region, returns their offset in the buffer or -1 if
+    // size is larger than a region
+    static GLintptr upload(const void* data, GLsizeiptr size);
+
+    static GLuint getBufferId();
+    static bool isPersistentlyMapped();
+
+    static const Stats& getStats();
+    static void printStats();
+
+private:
+    StreamBuffer() {} // Static only.
+};
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <GL/glew.h>
+#include "glshim.hpp"
 
+#include <glm.hpp>
+
+#include <memory>
 #include <string>
 
 class Texture
@@ -9,16 +12,29 @@ class Texture
 public:
     Texture();
     Texture(std::string fileLocation);
+    // Sub-rect of an atlas page, shares the page texture id
+    Texture(std::shared_ptr<Texture> atlas, int width, int height, const glm::vec4& uvRect);
 
     ~Texture()
     {
         clearTexture();
     }
 
+    // Owns a GL texture id, share it through TextureCache instead of copying
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
     void loadTexture();
+    // Tightly packed RGBA pixels, used to create atlas pages
+    void loadTexture(const unsigned char* rgbaData, int width, int height);
     void useTexture();
     void clearTexture();
 
+    GLuint getTextureId()
+    {
+        return m_texture_id;
+    }
+
     int getTextureWidth()
     {
         return m_width;
@@ -29,7 +45,24 @@ public:
         return m_height;
     }
 
+    // (u0, v0, u1, v1), the whole texture unless it lives in an atlas
+    const glm::vec4& getUVRect()
+    {
+        return m_uv_rect;
+    }
+
+    // Uploaded as GL_RGBA, base level only. Atlas views are accounted by their page.
+    size_t getTextureByteSize()
+    {
+        if (m_atlas != nullptr)
+            return 0;
+
+        return static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * 4;
+    }
+
 protected:
+    void uploadTexture(const unsigned char* rgbaData, GLint wrapMode);
+
     GLuint m_texture_id;
 
     int m_width;
@@ -37,4 +70,7 @@ protected:
     int m_bit_depth;
 
     std::string m_file_location;
+
+    glm::vec4 m_uv_rect;
+    std::shared_ptr<Texture> m_atlas;
 };
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "texture.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Packs small static images (UI, tiles, floor objects, doors) into one GL texture at
+ * startup, so SpriteBatch can draw whole menu and map layers without a rebind.
+ *
+ * Placement uses a skyline bottom-left heuristic. Every image is surrounded by a padding
+ * ring filled with its own edge pixels (extrusion), so filtering never picks up a
+ * neighbour. TextureCache asks the atlas first and hands packed files out as Texture views
+ * that share the page texture id and carry the sub-rect uv.
+ */
+class TextureAtlas
+{
+public:
+    struct Region
+    {
+        int width;
+        int height;
+        glm::vec4 uvRect;
+    };
+
+    // Files that cannot be loaded or do not fit keep their own texture.
+    static void build(const std::vector<std::string>& filePaths);
+
+    static bool findRegion(const std::string& filePath, Region& region);
+
+    static std::shared_ptr<Texture> getPage();
+
+    static void printStats();
+
+    // Delete the page while the context is still current. Views still around keep a dead id.
+    static void release();
+
+private:
+    TextureAtlas() {} // Static only.
+};
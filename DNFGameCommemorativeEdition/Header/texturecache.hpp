@@ -0,0 +1,34 @@
+#pragma once
+
+#include "texture.hpp"
+
+#include <memory>
+#include <string>
+
+/*
+ * Process-wide texture cache keyed by file location.
+ *
+ * Every entity used to own its own Texture, so each grass tile or goblin decoded and uploaded
+ * the same png again. acquire() hands out shared handles instead: the first caller pays for
+ * stbi_load + glTexImage2D, everyone else gets the same GL texture. The texture is deleted
+ * once the last handle goes away.
+ */
+class TextureCache
+{
+public:
+    struct Stats
+    {
+        unsigned int hits;
+        unsigned int misses;
+        unsigned int residentTextures;
+        size_t residentBytes;
+    };
+
+    static std::shared_ptr<Texture> acquire(const std::string& fileLocation);
+
+    static Stats getStats();
+    static void printStats();
+
+private:
+    TextureCache() {} // Static only.
+};
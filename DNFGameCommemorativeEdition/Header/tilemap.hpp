@@ -0,0 +1,84 @@
+#pragma once
+
+#include "shaderprogram.hpp"
+#include "texturecache.hpp"
+#include "geometrynode.hpp"
+
+#include "glshim.hpp"
+
+#include <glm.hpp>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Layer zero
+ *
+ * Static floor tiles of a map, baked into one vertex buffer per chunk of chunkWidth
+ * pixels when the map is built. Tile art is packed in the texture atlas, so a chunk is
+ * drawn with a single glDrawArrays no matter how many tiles it holds, chunks out of the
+ * view are skipped.
+ *
+ * Tiles are drawn in the order they are added, later tiles blend over earlier ones.
+ */
+class TileMap : public GeometryNode
+{
+public:
+    // clang-format off
+    static constexpr GLfloat chunkWidth {2048.0f};
+    // clang-format on
+
+    TileMap(const std::string& name, ShaderProgram* shader);
+    ~TileMap();
+
+    // Queue a tile covering origin to origin + size in the map space, call build() after
+    void addTile(const glm::vec2& origin,
+                 const glm::vec2& size,
+                 const std::shared_ptr<Texture>& texture);
+
+    // Upload the queued tiles, once per map
+    void build();
+
+    // Keeps which chunks overlap viewRect for draw()
+    bool isVisible(const glm::vec4& viewRect) override;
+    glm::vec4 getWorldBounds() override;
+    RenderState getRenderState() override;
+    void draw() override;
+
+    unsigned int getTilesCount() const
+    {
+        return m_tiles_count;
+    }
+
+    unsigned int getChunksCount() const
+    {
+        return static_cast<unsigned int>(m_chunks.size());
+    }
+
+private:
+    struct Chunk
+    {
+        int column;
+        GLuint textureId;
+        // (left, bottom, right, top) in the map space
+        glm::vec4 bounds;
+        bool visible;
+        // x, y, z, u, v per vertex
+        std::vector<GLfloat> vertices;
+
+        GLuint vao;
+        GLuint vbo;
+        GLsizei verticesCount;
+    };
+
+    glm::vec4 getChunkWorldBounds(const Chunk& chunk) const;
+
+    ShaderProgram* m_shader;
+    ShaderProgram::UniformId m_draw_text_uni_id;
+
+    std::vector<Chunk> m_chunks;
+    unsigned int m_tiles_count;
+
+    // Keeps the tile art (and its atlas page) alive while the chunks reference it
+    std::vector<std::shared_ptr<Texture>> m_textures;
+};
@@ -0,0 +1,74 @@
+#version 330
+
+// Sprite sheets of the clips bound for this draw, unit i holds slot i
+uniform sampler2D sheets[8];
+
+// Outline
+uniform vec4 outlineColor = vec4(0.65, 0.96, 0.19, 1.0);
+
+// Hit
+uniform vec3 hitColour = vec3(0.52, 0.04, 0.04);
+
+in vec2 TextureCoor;
+flat in int Sheet;
+flat in int Flags;
+
+out vec4 fragColor;
+
+// GLSL 3.30 can only index sampler arrays with constant expressions
+vec4 sampleSheet(vec2 textureCoor) {
+	switch (Sheet) {
+	case 0: return texture(sheets[0], textureCoor);
+	case 1: return texture(sheets[1], textureCoor);
+	case 2: return texture(sheets[2], textureCoor);
+	case 3: return texture(sheets[3], textureCoor);
+	case 4: return texture(sheets[4], textureCoor);
+	case 5: return texture(sheets[5], textureCoor);
+	case 6: return texture(sheets[6], textureCoor);
+	default: return texture(sheets[7], textureCoor);
+	}
+}
+
+ivec2 sheetSize() {
+	switch (Sheet) {
+	case 0: return textureSize(sheets[0], 0);
+	case 1: return textureSize(sheets[1], 0);
+	case 2: return textureSize(sheets[2], 0);
+	case 3: return textureSize(sheets[3], 0);
+	case 4: return textureSize(sheets[4], 0);
+	case 5: return textureSize(sheets[5], 0);
+	case 6: return textureSize(sheets[6], 0);
+	default: return textureSize(sheets[7], 0);
+	}
+}
+
+/*
+ * Same outline and hit tint as shader.frag.
+ */
+void main() {
+	vec4 resultColor;
+	vec4 spriteColor = sampleSheet(TextureCoor);
+
+	if ((Flags & 2) != 0) {
+		float sizeX = 1.0 / float(sheetSize().x);
+		float sizeY = 1.0 / float(sheetSize().y);
+
+		bool rightHasColor = sampleSheet(TextureCoor + vec2(sizeX, 0)).a < 1.0;
+		bool leftHasColor = sampleSheet(TextureCoor + vec2(-sizeX,0)).a < 1.0;
+		bool bottomHasColor = sampleSheet(TextureCoor + vec2(0, sizeY)).a < 1.0;
+		bool topHasColor = sampleSheet(TextureCoor + vec2(0, -sizeY)).a < 1.0;
+
+		if (((rightHasColor && !leftHasColor) || (leftHasColor && !rightHasColor) ||
+			(bottomHasColor && !topHasColor) || (bottomHasColor && !topHasColor))) {
+			resultColor = outlineColor;
+		} else {
+			resultColor = spriteColor;
+		}
+	} else if ((Flags & 1) != 0) {
+		resultColor = spriteColor * vec4(hitColour, 1.0);
+	} else {
+		resultColor = spriteColor;
+	}
+
+	fragColor = resultColor;
+}
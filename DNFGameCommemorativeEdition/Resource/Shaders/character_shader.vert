@@ -0,0 +1,54 @@
+#version 330
+
+// Shared with every program, filled once per frame
+layout(std140) uniform Camera {
+	mat4 P;
+	mat4 V;
+};
+
+// Frame uv rects of the clips bound for this draw, unit 8 + i holds slot i
+uniform samplerBuffer frames[8];
+
+// UnitQuad::corners in constant.hpp, two triangles
+const vec2 corners[6] = vec2[6](vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(0.0, 0.0),
+                                vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0));
+
+// Per character instance
+in mat4 model;
+// x: clip slot, y: frame index in the clip, z: 1 hit, 2 outline, 4 flip
+in vec3 clipFrameAndFlags;
+
+out vec2 TextureCoor;
+flat out int Sheet;
+flat out int Flags;
+
+// GLSL 3.30 can only index sampler arrays with constant expressions
+vec4 fetchFrame(int clip, int frame) {
+	switch (clip) {
+	case 0: return texelFetch(frames[0], frame);
+	case 1: return texelFetch(frames[1], frame);
+	case 2: return texelFetch(frames[2], frame);
+	case 3: return texelFetch(frames[3], frame);
+	case 4: return texelFetch(frames[4], frame);
+	case 5: return texelFetch(frames[5], frame);
+	case 6: return texelFetch(frames[6], frame);
+	default: return texelFetch(frames[7], frame);
+	}
+}
+
+void main() {
+	vec2 corner = corners[gl_VertexID];
+
+	gl_Position = P * V * model * vec4(corner, 0.0, 1.0);
+
+	Sheet = int(clipFrameAndFlags.x);
+	Flags = int(clipFrameAndFlags.z);
+
+	// u0, v0, u1, v1 of the frame in the sprite sheet, mirrored by swapping u0 and u1
+	vec4 uvRect = fetchFrame(Sheet, int(clipFrameAndFlags.y));
+	if ((Flags & 4) != 0)
+		uvRect = uvRect.zyxw;
+
+	// Sprite planes are flipped in u, same layout as the sprite quads
+	TextureCoor = vec2(mix(uvRect.z, uvRect.x, corner.x), mix(uvRect.y, uvRect.w, corner.y));
+}
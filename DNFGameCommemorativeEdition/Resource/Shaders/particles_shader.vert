@@ -1,25 +1,33 @@
 #version 330
 
-uniform mat4 P;
-uniform mat4 V;
+// Shared with every program, filled once per frame
+layout(std140) uniform Camera {
+	mat4 P;
+	mat4 V;
+};
+
 uniform mat4 M;
 
-// Position here is the origin of the particle system
-in vec3 position;
+// UnitQuad::corners in constant.hpp, two triangles
+const vec2 corners[6] = vec2[6](vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(0.0, 0.0),
+                                vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0));
+
 // PosOffset is the particle position offset, this is in world space
 in vec3 posOffset;
-in vec2 textureCoor;
 
 out vec2 TextureCoor;
 
 void main() {
+	vec2 corner = corners[gl_VertexID];
 	vec4 finalPos;
 
-	finalPos = M * vec4(position, 1.0);
+	// The corner is relative to the origin of the particle system
+	finalPos = M * vec4(corner, 0.0, 1.0);
 	finalPos.x = finalPos.x + posOffset.x;
 	finalPos.y = finalPos.y + posOffset.y;
 
 	gl_Position = P * V * finalPos;
 
-	TextureCoor = textureCoor;
+	// Flipped in u, same layout as the sprite quads
+	TextureCoor = vec2(1.0 - corner.x, corner.y);
 }
@@ -1,7 +1,11 @@
 #version 330
 
-uniform mat4 P;
-uniform mat4 V;
+// Shared with every program, filled once per frame
+layout(std140) uniform Camera {
+	mat4 P;
+	mat4 V;
+};
+
 uniform mat4 M;
 
 in vec3 position;
@@ -1,24 +1,33 @@
 #version 330
 
-uniform mat4 P;
-uniform mat4 V;
-uniform mat4 M;
-uniform float tilt = 0.4;
-uniform float scale = 0.3;
+// Shared with every program, filled once per frame
+layout(std140) uniform Camera {
+	mat4 P;
+	mat4 V;
+};
 
-in vec3 position;
-in vec2 textureCoor;
+// UnitQuad::corners in constant.hpp, two triangles
+const vec2 corners[6] = vec2[6](vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(0.0, 0.0),
+                                vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0));
+
+// Per shadow instance
+in mat4 model;
+// u0, v0, u1, v1 of the frame in the sprite sheet
+in vec4 uvRect;
+// x: tilt, y: scale
+in vec2 shear;
 
 out vec2 TextureCoor;
 
 void main() {
+	vec2 corner = corners[gl_VertexID];
+
 	// Do shear transformation
-	mat3 mat_scale = mat3(vec3(1.0,0.0,0.0),vec3(0.0,1.0,0.0),vec3(0.0,0.0,1.0));
-	mat3 mat_tilt = mat3(vec3(1.0, tilt, 0.0), vec3(0.0, scale, 0.0), vec3(0.0, 0.0, 1.0));
-	mat3 mul = mat_scale * mat_tilt;
-	vec3 temp = position * mul;
-	
-	gl_Position =  P * V * M * vec4(temp, 1.0);
-
-	TextureCoor = textureCoor;
+	mat3 mat_tilt = mat3(vec3(1.0, shear.x, 0.0), vec3(0.0, shear.y, 0.0), vec3(0.0, 0.0, 1.0));
+	vec3 temp = vec3(corner, 0.0) * mat_tilt;
+
+	gl_Position =  P * V * model * vec4(temp, 1.0);
+
+	// Sprite planes are flipped in u, same layout as the sprite quads
+	TextureCoor = vec2(mix(uvRect.z, uvRect.x, corner.x), mix(uvRect.y, uvRect.w, corner.y));
 }
@@ -0,0 +1,121 @@
+#include "animationclip.hpp"
+#include "spritesheetdata.hpp"
+#include "glstatecache.hpp"
+#include "glerrorcheck.hpp"
+
+#include <gtc/matrix_transform.hpp>
+
+AnimationClip::AnimationClip(const std::string& jsonPath, std::shared_ptr<Texture> texturesSheet)
+    : m_textures_sheet(texturesSheet)
+{
+    SpriteSheetData::Sheet sheet = SpriteSheetData::load(jsonPath);
+
+    // The sheet may be a view into an atlas page
+    const glm::vec4& sheetUVRect = m_textures_sheet->getUVRect();
+    float sheetWidth = static_cast<float>(m_textures_sheet->getTextureWidth());
+    float sheetHeight = static_cast<float>(m_textures_sheet->getTextureHeight());
+
+    m_frames.reserve(sheet.frames.size());
+    for (const auto& sheetFrame : sheet.frames) {
+        float texX = static_cast<float>(sheetFrame.x);
+        float texY = static_cast<float>(sheetFrame.y);
+        float texW = static_cast<float>(sheetFrame.w);
+        float texH = static_cast<float>(sheetFrame.h);
+
+        Frame frame;
+        frame.uvRect = glm::vec4(
+            sheetUVRect.x + texX / sheetWidth * (sheetUVRect.z - sheetUVRect.x),
+            sheetUVRect.y + texY / sheetHeight * (sheetUVRect.w - sheetUVRect.y),
+            sheetUVRect.x + (texX + texW) / sheetWidth * (sheetUVRect.z - sheetUVRect.x),
+            sheetUVRect.y + (texY + texH) / sheetHeight * (sheetUVRect.w - sheetUVRect.y));
+        frame.size = glm::vec2(texW, texH);
+        // spriteSourceSize is y down from the top of the untrimmed frame
+        frame.offset = glm::vec2(static_cast<float>(sheetFrame.trimX),
+                                 static_cast<float>(sheetFrame.sourceH - sheetFrame.trimY
+                                                    - sheetFrame.trimH));
+        frame.sourceSize = glm::vec2(static_cast<float>(sheetFrame.sourceW),
+                                     static_cast<float>(sheetFrame.sourceH));
+
+        m_frames.push_back(frame);
+    }
+
+    std::vector<glm::vec4> uvRects;
+    uvRects.reserve(m_frames.size());
+    for (const auto& frame : m_frames)
+        uvRects.push_back(frame.uvRect);
+
+    // Written once, the clip is immutable
+    glGenBuffers(1, &m_frames_tbo);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_frames_tbo);
+    glBufferData(GL_TEXTURE_BUFFER,
+                 uvRects.size() * sizeof(glm::vec4),
+                 uvRects.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &m_frames_texture);
+    GLStateCache::bindTextureBuffer(0, m_frames_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_frames_tbo);
+
+    CHECK_GL_ERRORS;
+}
+
+AnimationClip::~AnimationClip()
+{
+    GLStateCache::onTextureDeleted(m_frames_texture);
+    glDeleteTextures(1, &m_frames_texture);
+    glDeleteBuffers(1, &m_frames_tbo);
+}
+
+glm::mat4
+AnimationClip::getQuadTransform(const Frame& frame, bool flip)
+{
+    float offsetX = flip ? frame.sourceSize.x - frame.offset.x - frame.size.x : frame.offset.x;
+
+    // T * S * T * R * T^-1
+    // Scale will have no effect on translation
+    auto quadTrans = glm::translate(glm::mat4(1.0f), glm::vec3(offsetX, frame.offset.y, 0.0f));
+    quadTrans = glm::scale(quadTrans, glm::vec3(frame.size.x, frame.size.y, 1.0f));
+    quadTrans = glm::translate(quadTrans, glm::vec3(0.5f, 0.5f, 0.0f));
+    quadTrans = glm::rotate(quadTrans, glm::radians(180.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    quadTrans = glm::translate(quadTrans, glm::vec3(-0.5f, -0.5f, 0.0f));
+
+    return quadTrans;
+}
+
+glm::vec4
+AnimationClip::getQuadUVRect(const Frame& frame, bool flip)
+{
+    if (flip)
+        return glm::vec4(frame.uvRect.z, frame.uvRect.y, frame.uvRect.x, frame.uvRect.w);
+
+    return frame.uvRect;
+}
+
+AnimationPlayback::AnimationPlayback()
+    : m_clip(nullptr)
+    , m_frame_index(0)
+    , m_time_accumulator(0.0f)
+{}
+
+void
+AnimationPlayback::play(const AnimationClip* clip)
+{
+    m_clip = clip;
+    m_frame_index = 0;
+    m_time_accumulator = 0.0f;
+}
+
+bool
+AnimationPlayback::advance(float deltaTime, float frameDuration)
+{
+    m_time_accumulator = m_time_accumulator + deltaTime;
+
+    if (m_time_accumulator <= frameDuration)
+        return false;
+
+    m_frame_index = (m_frame_index + 1) % m_clip->getFrameCount();
+    m_time_accumulator = 0.0f;
+
+    return true;
+}
@@ -0,0 +1,44 @@
+#include "animationcliplibrary.hpp"
+#include "texturecache.hpp"
+
+#include <unordered_map>
+
+using LibraryEntries = std::unordered_map<std::string, std::weak_ptr<const AnimationClip>>;
+
+static unsigned int m_loaded_clips_count {0};
+
+// Heap allocated on purpose, handles can still be released during static destruction.
+static LibraryEntries&
+getLibraryEntries()
+{
+    static auto* entries = new LibraryEntries();
+
+    return *entries;
+}
+
+std::shared_ptr<const AnimationClip>
+AnimationClipLibrary::acquire(const std::string& jsonPath, const std::string& texturesSheetPath)
+{
+    auto& entries = getLibraryEntries();
+
+    auto it = entries.find(jsonPath);
+    if (it != entries.end()) {
+        if (auto clip = it->second.lock())
+            return clip;
+    }
+
+    auto clip = std::make_shared<const AnimationClip>(jsonPath,
+                                                      TextureCache::acquire(texturesSheetPath));
+
+    m_loaded_clips_count++;
+
+    entries[jsonPath] = clip;
+
+    return clip;
+}
+
+unsigned int
+AnimationClipLibrary::getLoadedClipsCount()
+{
+    return m_loaded_clips_count;
+}
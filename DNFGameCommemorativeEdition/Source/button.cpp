@@ -1,28 +1,13 @@
 #include "button.hpp"
 #include "gamewindow.hpp"
 #include "constant.hpp"
+#include "exception.hpp"
 
 #include "glerrorcheck.hpp"
 
 #include <gtc/matrix_transform.hpp>
 
-// clang-format off
-
-// Button vertex at the live area origin with texture coord
-static const GLfloat button_vertex_buffer_data[] =
-{
-    // triangle 1
-    // x,    y,    z,    u,    v,
-    0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-    1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-    0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-    // triangle 2
-    1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-    1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-    0.0f, 0.0f, 0.0f, 1.0f, 0.0f
-};
-
-// clang-format on
+#include <string>
 
 // Hover offset const
 static const float m_buttonhover_x_offset {10.0f};
@@ -39,106 +24,58 @@ Button::Button(const std::string& name, ShaderProgram* shader, ButtonTextureType
     // Load texture
     switch (textureType) {
     case ButtonTextureType::ExitButton:
-        m_texture_normal = Texture(TexturePath::exitButtonNormalUIPath);
-        m_texture_hover = Texture(TexturePath::exitButtonHoverUIPath);
-
-        m_texture_hover.loadTexture();
+        m_texture_normal = TextureCache::acquire(TexturePath::exitButtonNormalUIPath);
+        m_texture_hover = TextureCache::acquire(TexturePath::exitButtonHoverUIPath);
         break;
     case ButtonTextureType::PlayButton:
-        m_texture_normal = Texture(TexturePath::playButtonNormalUIPath);
-        m_texture_hover = Texture(TexturePath::playButtonHoverUIPath);
-
-        m_texture_hover.loadTexture();
+        m_texture_normal = TextureCache::acquire(TexturePath::playButtonNormalUIPath);
+        m_texture_hover = TextureCache::acquire(TexturePath::playButtonHoverUIPath);
         break;
     case ButtonTextureType::ControlButton:
-        m_texture_normal = Texture(TexturePath::controlButtonNormalUIPath);
-        m_texture_hover = Texture(TexturePath::controlButtonHoverUIPath);
-
-        m_texture_hover.loadTexture();
+        m_texture_normal = TextureCache::acquire(TexturePath::controlButtonNormalUIPath);
+        m_texture_hover = TextureCache::acquire(TexturePath::controlButtonHoverUIPath);
         break;
     case ButtonTextureType::BackButton:
-        m_texture_normal = Texture(TexturePath::backButtonNormalUIPath);
-        m_texture_hover = Texture(TexturePath::backButtonHoverUIPath);
-
-        m_texture_hover.loadTexture();
+        m_texture_normal = TextureCache::acquire(TexturePath::backButtonNormalUIPath);
+        m_texture_hover = TextureCache::acquire(TexturePath::backButtonHoverUIPath);
         break;
     case ButtonTextureType::Logo:
-        m_texture_normal = Texture(TexturePath::dnfLogoPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::dnfLogoPath);
         break;
     case ButtonTextureType::Victory:
-        m_texture_normal = Texture(TexturePath::victoryPNGPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::victoryPNGPath);
         break;
     case ButtonTextureType::AttackLabel:
-        m_texture_normal = Texture(TexturePath::attackLabelPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::attackLabelPath);
         break;
     case ButtonTextureType::MoveLabel:
-        m_texture_normal = Texture(TexturePath::moveLabelPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::moveLabelPath);
         break;
     case ButtonTextureType::InteractLabel:
-        m_texture_normal = Texture(TexturePath::interactLabelPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::interactLabelPath);
         break;
     case ButtonTextureType::ZKey:
-        m_texture_normal = Texture(TexturePath::zKeyPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::zKeyPath);
         break;
     case ButtonTextureType::XKey:
-        m_texture_normal = Texture(TexturePath::xKeyPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::xKeyPath);
         break;
     case ButtonTextureType::ArrowKey:
-        m_texture_normal = Texture(TexturePath::arrowKeyPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::arrowKeyPath);
         break;
     case ButtonTextureType::MouseLeft:
-        m_texture_normal = Texture(TexturePath::mouseLeftPath);
+        m_texture_normal = TextureCache::acquire(TexturePath::mouseLeftPath);
         break;
     default:
-        break;
+        throw Exception("Unknown button texture type: "
+                        + std::to_string(static_cast<int>(textureType)));
     }
 
-    m_texture_normal.loadTexture();
-
-    m_plane_width = static_cast<float>(m_texture_normal.getTextureWidth());
-    m_plane_height = static_cast<float>(m_texture_normal.getTextureHeight());
+    m_plane_width = static_cast<float>(m_texture_normal->getTextureWidth());
+    m_plane_height = static_cast<float>(m_texture_normal->getTextureHeight());
 
     // Init m_trans
     cleanMovement();
-
-    // Create the vertex array to record buffer assignments for button.
-    glGenVertexArrays(1, &m_button_vao);
-    glBindVertexArray(m_button_vao);
-
-    // Create the cube vertex buffer
-    glGenBuffers(1, &m_button_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_button_vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 sizeof(button_vertex_buffer_data),
-                 button_vertex_buffer_data,
-                 GL_STATIC_DRAW);
-
-    // Specify the means of extracting the position values properly.
-    m_position_attrib_pos = m_shader->getAttribLocation("position");
-    glEnableVertexAttribArray(m_position_attrib_pos);
-    glVertexAttribPointer(m_position_attrib_pos,
-                          3,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(button_vertex_buffer_data[0]) * 5,
-                          nullptr);
-
-    // texture coord
-    m_texture_coor_attrib_pos = m_shader->getAttribLocation("textureCoor");
-    glEnableVertexAttribArray(m_texture_coor_attrib_pos);
-    glVertexAttribPointer(m_texture_coor_attrib_pos,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(button_vertex_buffer_data[0]) * 5,
-                          (void*) (sizeof(button_vertex_buffer_data[0]) * 3));
-
-    // Reset state to prevent rogue code from messing with *my*
-    // stuff!
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    CHECK_GL_ERRORS;
 }
 
 void
@@ -176,10 +113,11 @@ bool
 Button::checkOnTop(const glm::vec2& mousePos)
 {
     if (m_buttonhover_x_offset + m_button_dx < mousePos.x
-        && mousePos.x < m_button_dx + m_texture_normal.getTextureWidth() - m_buttonhover_x_offset) {
+        && mousePos.x
+               < m_button_dx + m_texture_normal->getTextureWidth() - m_buttonhover_x_offset) {
         if (m_button_hover_y_offset + m_button_dy < mousePos.y
             && mousePos.y
-                   < m_button_dy + m_texture_normal.getTextureHeight() - m_button_hover_y_offset) {
+                   < m_button_dy + m_texture_normal->getTextureHeight() - m_button_hover_y_offset) {
             m_button_is_hovered = true;
             return m_button_is_hovered;
         }
@@ -192,20 +130,15 @@ Button::checkOnTop(const glm::vec2& mousePos)
 void
 Button::translateToWindowCenter(float dx, float windowWidth, float windowHeight)
 {
-    translate(glm::vec3(dx + windowWidth / 2.0f - m_texture_normal.getTextureWidth() / 2.0f,
-                        windowHeight / 2.0f - m_texture_normal.getTextureHeight() / 2.0f,
+    translate(glm::vec3(dx + windowWidth / 2.0f - m_texture_normal->getTextureWidth() / 2.0f,
+                        windowHeight / 2.0f - m_texture_normal->getTextureHeight() / 2.0f,
                         0.0f));
 }
 
-void
-Button::draw()
+Texture*
+Button::getCurrentTexture()
 {
-    // Draw transparent backgrounds in blend mode (alpha channel)
-    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
-    glDepthMask(GL_FALSE);
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    Texture* texture {m_texture_normal.get()};
 
     switch (m_current_button_t_type) {
     case Button::ButtonTextureType::ExitButton:
@@ -214,10 +147,10 @@ Button::draw()
     case Button::ButtonTextureType::BackButton:
         switch (m_button_is_hovered) {
         case false:
-            m_texture_normal.useTexture();
+            texture = m_texture_normal.get();
             break;
         case true:
-            m_texture_hover.useTexture();
+            texture = m_texture_hover.get();
             break;
         }
         break;
@@ -230,16 +163,27 @@ Button::draw()
     case Button::ButtonTextureType::ZKey:
     case Button::ButtonTextureType::XKey:
     case Button::ButtonTextureType::ArrowKey:
-        m_texture_normal.useTexture();
+        texture = m_texture_normal.get();
         break;
     default:
         break;
     }
 
-    glBindVertexArray(m_button_vao);
-    glDrawArrays(GL_TRIANGLES, 0, 3 * 2);
-    glBindVertexArray(0);
+    return texture;
+}
+
+bool
+Button::submitToBatch(SpriteBatch& spriteBatch)
+{
+    Texture* texture = getCurrentTexture();
 
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    spriteBatch.submit(m_world_trans, texture->getTextureId(), texture->getUVRect());
+
+    return true;
+}
+
+SceneNode::RenderState
+Button::getRenderState()
+{
+    return {RenderProgram::Sprite, getCurrentTexture()->getTextureId()};
 }
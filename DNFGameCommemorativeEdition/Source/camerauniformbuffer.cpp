@@ -0,0 +1,51 @@
+#include "camerauniformbuffer.hpp"
+#include "constant.hpp"
+
+#include <gtc/type_ptr.hpp>
+
+CameraUniformBuffer::CameraUniformBuffer()
+    : m_ubo(0)
+    , m_proj(glm::mat4(1.0f))
+    , m_view(glm::mat4(1.0f))
+{}
+
+CameraUniformBuffer::~CameraUniformBuffer()
+{
+    if (m_ubo != 0)
+        glDeleteBuffers(1, &m_ubo);
+}
+
+/*
+ * Allocate the buffer and attach it to the camera binding point.
+ * Needs a current GL context.
+ */
+void
+CameraUniformBuffer::init()
+{
+    glGenBuffers(1, &m_ubo);
+
+    // std140: two column-major mat4, no padding needed
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, CameraBlock::bindingPoint, m_ubo);
+}
+
+void
+CameraUniformBuffer::update(const glm::mat4& proj, const glm::mat4& view)
+{
+    m_proj = proj;
+    m_view = view;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(proj));
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void
+CameraUniformBuffer::bindProgram(ShaderProgram& program)
+{
+    program.bindUniformBlock(CameraBlock::blockName.c_str(), CameraBlock::bindingPoint);
+}
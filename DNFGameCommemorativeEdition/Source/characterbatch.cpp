@@ -0,0 +1,217 @@
+#include "characterbatch.hpp"
+#include "shadercache.hpp"
+#include "constant.hpp"
+
+#include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+#include "streambuffer.hpp"
+
+#include <algorithm>
+
+// clang-format off
+
+// mat4 + vec3
+static const int m_floats_per_instance {19};
+
+// Bits of clipFrameAndFlags.z in character_shader
+static const int m_hit_flag {1};
+static const int m_outline_flag {2};
+static const int m_flip_flag {4};
+
+// clang-format on
+
+static_assert(2 * CharacterBatch::maxClipsPerDraw <= GLStateCache::maxTextureUnits,
+              "Sheets and frame tables of a draw need their own texture units");
+
+CharacterBatch::CharacterBatch()
+{
+    // Character shader is shared by all characters
+    m_character_shader = ShaderCache::acquire(CharacterShaderPath::vertexShader,
+                                              CharacterShaderPath::fragmentShader);
+
+    m_model_attrib_pos = m_character_shader->getAttribLocation("model");
+    m_clip_frame_and_flags_attrib_pos = m_character_shader->getAttribLocation(
+        "clipFrameAndFlags");
+
+    // Clip slot i samples its sheet from unit i and its frames from unit maxClipsPerDraw + i
+    GLint sheetUnits[maxClipsPerDraw];
+    GLint framesUnits[maxClipsPerDraw];
+    for (unsigned int i = 0; i < maxClipsPerDraw; i++) {
+        sheetUnits[i] = static_cast<GLint>(i);
+        framesUnits[i] = static_cast<GLint>(maxClipsPerDraw + i);
+    }
+
+    m_character_shader->enable();
+    glUniform1iv(m_character_shader->getUniformLocation("sheets[0]"),
+                 maxClipsPerDraw,
+                 sheetUnits);
+    glUniform1iv(m_character_shader->getUniformLocation("frames[0]"),
+                 maxClipsPerDraw,
+                 framesUnits);
+
+    // Create the vertex array to record buffer assignments for the batch.
+    glGenVertexArrays(1, &m_character_batch_vao);
+    glBindVertexArray(m_character_batch_vao);
+
+    // No per vertex buffer, the shader builds the unit quad from gl_VertexID.
+    // Instances are streamed on flush, the pointers are set per draw.
+    // mat4 takes four consecutive attribute locations
+    for (GLuint i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(m_model_attrib_pos + i);
+        glVertexAttribDivisor(m_model_attrib_pos + i, 1);
+    }
+
+    glEnableVertexAttribArray(m_clip_frame_and_flags_attrib_pos);
+    glVertexAttribDivisor(m_clip_frame_and_flags_attrib_pos, 1);
+
+    // Reset state to prevent rogue code from messing with *my* stuff!
+    glBindVertexArray(0);
+
+    CHECK_GL_ERRORS;
+}
+
+CharacterBatch::~CharacterBatch()
+{
+    glDeleteVertexArrays(1, &m_character_batch_vao);
+}
+
+void
+CharacterBatch::setInstanceAttribPointers(GLintptr base)
+{
+    // GL 3.3 has no base instance, offset the instance attributes instead
+    GLsizei stride = sizeof(GLfloat) * m_floats_per_instance;
+
+    for (GLuint i = 0; i < 4; i++) {
+        glVertexAttribPointer(m_model_attrib_pos + i,
+                              4,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              stride,
+                              (void*) (base + sizeof(GLfloat) * 4 * i));
+    }
+
+    glVertexAttribPointer(m_clip_frame_and_flags_attrib_pos,
+                          3,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*) (base + sizeof(GLfloat) * 16));
+}
+
+void
+CharacterBatch::submit(const glm::mat4& modelMat,
+                       const AnimationClip* clip,
+                       unsigned int frameIndex,
+                       bool flip,
+                       bool hit,
+                       bool outline)
+{
+    int flags = (hit ? m_hit_flag : 0) | (outline ? m_outline_flag : 0)
+                | (flip ? m_flip_flag : 0);
+
+    m_instances.push_back(
+        {modelMat, clip, static_cast<GLfloat>(frameIndex), static_cast<GLfloat>(flags)});
+}
+
+bool
+CharacterBatch::flush()
+{
+    if (m_instances.empty())
+        return false;
+
+    // Split into draws of at most maxClipsPerDraw clips, keeping the submission order
+    m_draws.clear();
+    m_instance_data.clear();
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        const Instance& instance = m_instances[i];
+
+        if (m_draws.empty())
+            m_draws.push_back({i, 0, {}, 0});
+
+        Draw* draw = &m_draws.back();
+        const AnimationClip** clipsEnd = draw->clips + draw->clipsCount;
+        const AnimationClip** clip = std::find(draw->clips, clipsEnd, instance.clip);
+
+        if (clip == clipsEnd) {
+            if (draw->clipsCount == maxClipsPerDraw) {
+                m_draws.push_back({i, 0, {}, 0});
+                draw = &m_draws.back();
+            }
+
+            clip = draw->clips + draw->clipsCount;
+            *clip = instance.clip;
+            draw->clipsCount++;
+        }
+
+        draw->instanceCount++;
+
+        const GLfloat* modelMat = &instance.modelMat[0][0];
+        m_instance_data.insert(m_instance_data.end(), modelMat, modelMat + 16);
+        m_instance_data.push_back(static_cast<GLfloat>(clip - draw->clips));
+        m_instance_data.push_back(instance.frameIndex);
+        m_instance_data.push_back(instance.flags);
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instance_data.size() * sizeof(GLfloat));
+    GLintptr offset = StreamBuffer::upload(m_instance_data.data(), size);
+
+    if (offset < 0) {
+        m_instances.clear();
+
+        return false;
+    }
+
+    m_character_shader->enable();
+
+    // Draw transparent backgrounds in blend mode (alpha channel)
+    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
+    GLStateCache::depthMask(GL_FALSE);
+
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(m_character_batch_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, StreamBuffer::getBufferId());
+
+    for (const auto& draw : m_draws) {
+        for (unsigned int i = 0; i < draw.clipsCount; i++) {
+            GLStateCache::bindTexture2D(i, draw.clips[i]->getTexturesSheet()->getTextureId());
+            GLStateCache::bindTextureBuffer(maxClipsPerDraw + i,
+                                            draw.clips[i]->getFramesTexture());
+        }
+
+        setInstanceAttribPointers(offset
+                                  + draw.firstInstance * sizeof(GLfloat) * m_floats_per_instance);
+        glDrawArraysInstanced(GL_TRIANGLES,
+                              0,
+                              UnitQuad::verticesCount,
+                              static_cast<GLsizei>(draw.instanceCount));
+
+        m_stats.drawCalls++;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
+
+    m_stats.instances += static_cast<unsigned int>(m_instances.size());
+    m_instances.clear();
+
+    CHECK_GL_ERRORS;
+
+    return true;
+}
+
+void
+CharacterBatch::resetStats()
+{
+    m_stats = Stats();
+}
+
+const CharacterBatch::Stats&
+CharacterBatch::getStats() const
+{
+    return m_stats;
+}
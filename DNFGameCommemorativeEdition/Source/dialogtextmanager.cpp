@@ -2,6 +2,7 @@
 #include "gamewindow.hpp"
 
 #include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
 
 #include <gtc/matrix_transform.hpp>
 
@@ -52,7 +53,7 @@ DialogTextManager::initialize()
         // Generate texture
         GLuint textureId;
         glGenTextures(1, &textureId);
-        glBindTexture(GL_TEXTURE_2D, textureId);
+        GLStateCache::bindTexture2D(textureId);
         glTexImage2D(GL_TEXTURE_2D,
                      0,
                      GL_RED,
@@ -102,7 +103,7 @@ DialogTextManager::initialize()
         // Generate texture
         GLuint textureId;
         glGenTextures(1, &textureId);
-        glBindTexture(GL_TEXTURE_2D, textureId);
+        GLStateCache::bindTexture2D(textureId);
         glTexImage2D(GL_TEXTURE_2D,
                      0,
                      GL_RED,
@@ -128,7 +129,7 @@ DialogTextManager::initialize()
     }
 
     // Unbind texture.
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture2D(0);
 
     // Destroy FreeType once we're finished.
     FT_Done_Face(faceEN);
@@ -0,0 +1,112 @@
+#include "framescheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// clang-format off
+
+static const std::chrono::milliseconds m_sleep_step {1};
+// Until a sleep has been measured
+static const std::chrono::milliseconds m_initial_sleep_overshoot {2};
+
+// clang-format on
+
+FrameScheduler::FrameScheduler(float targetFps)
+    : m_target_fps(0.0f)
+    , m_frame_period(Clock::duration::zero())
+    , m_sleep_overshoot(m_initial_sleep_overshoot)
+{
+    setTargetFps(targetFps);
+}
+
+void
+FrameScheduler::setTargetFps(float targetFps)
+{
+    m_target_fps = std::max(targetFps, 0.0f);
+
+    if (m_target_fps > 0.0f)
+        m_frame_period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / m_target_fps));
+    else
+        m_frame_period = Clock::duration::zero();
+}
+
+float
+FrameScheduler::getTargetFps() const
+{
+    return m_target_fps;
+}
+
+void
+FrameScheduler::start()
+{
+    m_last_frame_end = Clock::now();
+    m_next_deadline = m_last_frame_end + m_frame_period;
+    m_stats = Stats();
+}
+
+float
+FrameScheduler::endFrame()
+{
+    if (m_frame_period > Clock::duration::zero()) {
+        waitUntil(m_next_deadline);
+
+        // Stay on the grid, unless a long frame left it more than a frame behind
+        m_next_deadline += m_frame_period;
+        Clock::time_point now = Clock::now();
+        if (now > m_next_deadline)
+            m_next_deadline = now + m_frame_period;
+    }
+
+    Clock::time_point frameEnd = Clock::now();
+    std::chrono::duration<double> delta = frameEnd - m_last_frame_end;
+    m_last_frame_end = frameEnd;
+
+    double deltaMs = delta.count() * 1000.0;
+    m_stats.frames++;
+    m_stats.totalMs += deltaMs;
+    m_stats.totalSquaredMs += deltaMs * deltaMs;
+    m_stats.worstMs = std::max(m_stats.worstMs, deltaMs);
+
+    return static_cast<float>(delta.count());
+}
+
+void
+FrameScheduler::waitUntil(Clock::time_point deadline)
+{
+    // Sleep while a whole sleep, overshoot included, still lands before the deadline
+    while (deadline - Clock::now() > m_sleep_overshoot + m_sleep_step) {
+        Clock::time_point before = Clock::now();
+        std::this_thread::sleep_for(m_sleep_step);
+        Clock::duration overshoot = Clock::now() - before - m_sleep_step;
+
+        // Follow the worst recent overshoot, let it decay slowly when the timer behaves
+        m_sleep_overshoot = std::max(overshoot, m_sleep_overshoot - m_sleep_overshoot / 64);
+    }
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+const FrameScheduler::Stats&
+FrameScheduler::getStats() const
+{
+    return m_stats;
+}
+
+void
+FrameScheduler::printStats() const
+{
+    double frames = std::max(m_stats.frames, 1u);
+    double averageMs = m_stats.totalMs / frames;
+    double jitterMs = std::sqrt(
+        std::max(m_stats.totalSquaredMs / frames - averageMs * averageMs, 0.0));
+
+    std::cout << "FrameScheduler target fps: " << m_target_fps << " (0 is uncapped)"
+              << ", frames: " << m_stats.frames << ", average: " << averageMs << " ms"
+              << ", jitter (std dev): " << jitterMs << " ms"
+              << ", worst: " << m_stats.worstMs << " ms" << std::endl;
+}
@@ -2,6 +2,10 @@
 #include "glerrorcheck.hpp"
 #include "constant.hpp"
 #include "monster.hpp"
+#include "texturecache.hpp"
+#include "textureatlas.hpp"
+#include "glstatecache.hpp"
+#include "streambuffer.hpp"
 
 #include <iostream>
 
@@ -44,7 +48,8 @@ Game::Game()
 // Destructor
 Game::~Game()
 {
-    m_game_sound_engine->drop();
+    if (m_game_sound_engine != nullptr)
+        m_game_sound_engine->drop();
 }
 
 /*
@@ -59,9 +64,13 @@ Game::init()
     m_shader.attachFragmentShader(getResourceFilePath("Shaders/shader.frag").c_str());
     m_shader.link();
 
+    m_camera_ubo.init();
+    CameraUniformBuffer::bindProgram(m_shader);
+
+    // Shared by every batch that uploads vertices or instances each frame
+    StreamBuffer::init();
+
     // Set up the uniforms
-    P_uni = m_shader.getUniformLocation("P");
-    V_uni = m_shader.getUniformLocation("V");
     M_uni = m_shader.getUniformLocation("M");
 
     // Set up initial view and projection matrices (need to do this here,
@@ -75,10 +84,14 @@ Game::init()
                         -1.0f,
                         1.0f);
 
+    // Before any sprite acquires its texture
+    TextureAtlas::build(TextureAtlasContent::filePaths);
+
     m_scene_manager = std::make_unique<SceneManager>(&m_shader,
                                                      static_cast<float>(m_framebufferWidth),
                                                      static_cast<float>(m_framebufferHeight),
-                                                     m_window);
+                                                     m_window,
+                                                     &m_camera_ubo);
 
     m_scene_manager->constructScenes();
 }
@@ -115,28 +128,36 @@ Game::guiLogic()
 void
 Game::draw()
 {
+    GLStateCache::beginFrame();
+#if (GL_SHIM)
+    GLShim::beginFrame();
+#endif
+    StreamBuffer::beginFrame();
+
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     m_shader.enable();
 
     // Enable depth test
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_DEPTH_TEST);
     // Accept fragment if it closer to the camera than the former one
-    glDepthFunc(GL_LESS);
-
-    glUniformMatrix4fv(P_uni, 1, GL_FALSE, value_ptr(m_proj));
-    glUniformMatrix4fv(V_uni, 1, GL_FALSE, value_ptr(m_view));
-    m_scene_manager->getPlayer()->updateShadowShaderPVMat(m_proj, m_view);
-    m_scene_manager->getNPC()->updateShadowShaderPVMat(m_proj, m_view);
-    m_scene_manager->getStarParticlesGenerator()->updateParticleShaderPVMat(m_proj, m_view);
-    for (auto& i : m_scene_manager->getMonsters()) {
-        i->updateShadowShaderPVMat(m_proj, m_view);
-    }
-
-    // Main drawing
+    GLStateCache::depthFunc(GL_LESS);
+
+    // One upload shared by the main, shadow and particle programs
+    m_camera_ubo.update(m_proj, m_view);
+
+    // Main drawing, anything outside of the window is culled
+    m_scene_manager->setViewRect(glm::vec4(m_camera_pos.x,
+                                           m_camera_pos.y,
+                                           m_camera_pos.x + m_framebufferWidth,
+                                           m_camera_pos.y + m_framebufferHeight));
+    // Parallax layers follow the camera, resets on a scene change included
+    m_scene_manager->scrollBackground(m_camera_pos.x);
     m_scene_manager->drawCurrentScene();
 
+    StreamBuffer::endFrame();
+
     m_shader.disable();
 
     CHECK_GL_ERRORS;
@@ -166,7 +187,19 @@ Game::convertMousePos(double xPos, double yPos)
  */
 void
 Game::cleanup()
-{}
+{
+    TextureCache::printStats();
+    TextureAtlas::printStats();
+    GLStateCache::printStats();
+#if (GL_SHIM)
+    GLShim::printStats();
+#endif
+    StreamBuffer::printStats();
+    m_scene_manager->printTraversalStats();
+
+    StreamBuffer::release();
+    TextureAtlas::release();
+}
 
 /*
  * Event handler.  Handles cursor entering the window area events.
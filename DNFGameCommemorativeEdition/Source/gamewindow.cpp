@@ -1,7 +1,8 @@
 #include "gamewindow.hpp"
 #include "constant.hpp"
 
-#include <GL/glew.h>
+#include "glshim.hpp"
+
 #include <GLFW/glfw3.h>
 
 #include <glm.hpp>
@@ -12,19 +13,31 @@
 
 #include <sstream>
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
 #include <cstdio>
-#include <ctime>
-#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <limits.h>
 
-#include <Windows.h>
-
 //-- Static member initialization:
 std::string GameWindow::m_exec_dir = ".";
-std::chrono::high_resolution_clock::time_point m_game_clock;
 std::shared_ptr<GameWindow> GameWindow::m_instance = nullptr;
 float m_game_delta_time {0.0f};
 
+// clang-format off
+
+static const std::string m_headless_option     {"--headless"};
+static const std::string m_frames_option       {"--frames"};
+static const std::string m_dump_frames_option  {"--dump-frames"};
+static const std::string m_fps_option          {"--fps"};
+static const std::string m_vsync_option        {"--vsync"};
+static const int m_default_headless_frames     {600};
+
+// clang-format on
+
 static void printGLInfo();
 
 //----------------------------------------------------------------------------------------
@@ -39,6 +52,10 @@ GameWindow::GameWindow()
     , m_framebufferHeight(0)
     , m_paused(false)
     , m_fullScreen(false)
+    , m_headless(false)
+    , m_headless_frames(m_default_headless_frames)
+    , m_vsync(false)
+    , m_frame_scheduler(0.0f)
 {}
 
 //----------------------------------------------------------------------------------------
@@ -260,7 +277,74 @@ GameWindow::launch(int argc,
 
     if (m_instance == nullptr) {
         m_instance = std::shared_ptr<GameWindow>(window);
-        m_instance->run(width, height, title, fps);
+        m_instance->m_frame_scheduler.setTargetFps(fps);
+        m_instance->parseLaunchOptions(argc, argv);
+        m_instance->run(width, height, title);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+void
+GameWindow::parseLaunchOptions(int argc, char** argv)
+{
+    bool fpsGiven {false};
+
+    for (int i = 1; i < argc; i++) {
+        std::string option {argv[i]};
+        bool hasValue = i + 1 < argc;
+
+        if (option == m_headless_option) {
+            m_headless = true;
+        } else if (option == m_frames_option && hasValue) {
+            m_headless_frames = std::max(1, std::atoi(argv[++i]));
+        } else if (option == m_dump_frames_option && hasValue) {
+            m_dump_frames_dir = argv[++i];
+        } else if (option == m_fps_option && hasValue) {
+            m_frame_scheduler.setTargetFps(static_cast<float>(std::atof(argv[++i])));
+            fpsGiven = true;
+        } else if (option == m_vsync_option) {
+            m_vsync = true;
+        } else {
+            std::cerr << "Unknown launch option: " << option << std::endl;
+        }
+    }
+
+    // Headless runs measure the frame cost, and vsync paces the loop on its own
+    if ((m_headless && !fpsGiven) || m_vsync)
+        m_frame_scheduler.setTargetFps(0.0f);
+}
+
+//----------------------------------------------------------------------------------------
+void
+GameWindow::dumpFrame(int frame)
+{
+    std::vector<unsigned char> pixels(m_framebufferWidth * m_framebufferHeight * 3);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0,
+                 0,
+                 m_framebufferWidth,
+                 m_framebufferHeight,
+                 GL_RGB,
+                 GL_UNSIGNED_BYTE,
+                 pixels.data());
+
+    std::stringstream path;
+    path << m_dump_frames_dir << "/frame_" << std::setw(5) << std::setfill('0') << frame
+         << ".ppm";
+
+    std::ofstream file(path.str(), std::ios::binary);
+    if (!file) {
+        std::cerr << "Can not write frame dump: " << path.str() << std::endl;
+        return;
+    }
+
+    file << "P6\n" << m_framebufferWidth << " " << m_framebufferHeight << "\n255\n";
+
+    // GL reads bottom row first, ppm is top row first
+    size_t rowSize = m_framebufferWidth * 3;
+    for (int row = m_framebufferHeight - 1; row >= 0; row--) {
+        file.write(reinterpret_cast<const char*>(pixels.data() + row * rowSize), rowSize);
     }
 }
 
@@ -272,17 +356,24 @@ GameWindow::getDeltaTime()
 }
 
 //----------------------------------------------------------------------------------------
-void
-GameWindow::run(int width, int height, const std::string& windowTitle, float desiredFramesPerSecond)
+bool
+GameWindow::createContext(int width, int height, const std::string& windowTitle)
 {
-    m_windowTitle = windowTitle;
-    m_windowWidth = width;
-    m_windowHeight = height;
-    glfwSetErrorCallback(errorCallback);
+#if (HEADLESS_EGL)
+    // No window system at all, the pbuffer is the framebuffer
+    if (m_headless) {
+        if (!m_headless_context.create(width, height))
+            return false;
+
+        m_framebufferWidth = width;
+        m_framebufferHeight = height;
+        return true;
+    }
+#endif
 
     if (glfwInit() == GL_FALSE) {
         fprintf(stderr, "Call to glfwInit() failed.\n");
-        std::abort();
+        return false;
     }
 
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
@@ -290,7 +381,7 @@ GameWindow::run(int width, int height, const std::string& windowTitle, float des
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, m_headless ? GL_FALSE : GL_TRUE);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
     glfwWindowHint(GLFW_SAMPLES, 0);
     glfwWindowHint(GLFW_RED_BITS, 8);
@@ -299,45 +390,97 @@ GameWindow::run(int width, int height, const std::string& windowTitle, float des
     glfwWindowHint(GLFW_ALPHA_BITS, 8);
 
     m_monitor = glfwGetPrimaryMonitor();
-    if (m_monitor == NULL) {
-        glfwTerminate();
+    if (m_monitor == NULL && !m_headless) {
         fprintf(stderr, "Error retrieving primary monitor.\n");
-        std::abort();
+        return false;
     }
 
     m_window = glfwCreateWindow(width, height, windowTitle.c_str(), NULL, NULL);
     if (m_window == NULL) {
-        glfwTerminate();
         fprintf(stderr, "Call to glfwCreateWindow failed.\n");
-        std::abort();
+        return false;
     }
 
     // Get default framebuffer dimensions in order to support high-definition
     // displays.
     glfwGetFramebufferSize(m_window, &m_framebufferWidth, &m_framebufferHeight);
 
-    centerWindow();
+    if (!m_headless)
+        centerWindow();
     glfwMakeContextCurrent(m_window);
 
+    return true;
+}
+
+//----------------------------------------------------------------------------------------
+bool
+GameWindow::shouldClose(int frame) const
+{
+    if (m_headless && frame >= m_headless_frames)
+        return true;
+
+    return m_window != nullptr && glfwWindowShouldClose(m_window);
+}
+
+//----------------------------------------------------------------------------------------
+void
+GameWindow::swapBuffers()
+{
+#if (HEADLESS_EGL)
+    if (m_window == nullptr) {
+        // Nothing shows a pbuffer, wait for the frame so the scheduler measures all of it
+        m_headless_context.swapBuffers();
+        glFinish();
+        return;
+    }
+#endif
+
+    glfwSwapBuffers(m_window);
+}
+
+//----------------------------------------------------------------------------------------
+void
+GameWindow::run(int width, int height, const std::string& windowTitle)
+{
+    m_windowTitle = windowTitle;
+    m_windowWidth = width;
+    m_windowHeight = height;
+    glfwSetErrorCallback(errorCallback);
+
+    if (!createContext(width, height, windowTitle)) {
+        glfwTerminate();
+        std::abort();
+    }
+
     // Allow modern extension features
     glewExperimental = GL_TRUE;
 
-    if (glewInit() != GLEW_OK) {
+    GLenum glewStatus = glewInit();
+#if (HEADLESS_EGL)
+    // A GLEW built for GLX loads the GL entry points first, then finds no GLX display
+    if (m_window == nullptr && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY)
+        glewStatus = GLEW_OK;
+#endif
+
+    if (glewStatus != GLEW_OK) {
         std::cout << ("GLEW initialisation failed!") << std::endl;
-        glfwDestroyWindow(m_window);
+        if (m_window != nullptr)
+            glfwDestroyWindow(m_window);
         glfwTerminate();
         return;
     }
 
-    glfwInit();
-
 #ifdef DEBUG_GL
     printGLInfo();
 #endif
 
-    glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    if (m_window != nullptr) {
+        glfwInit();
 
-    registerGlfwCallBacks();
+        glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+
+        registerGlfwCallBacks();
+    }
 
     // Make sure resize is run on initialization to get consistent results across platforms
     getInstance()->windowResizeEvent(width, height);
@@ -346,42 +489,46 @@ GameWindow::run(int width, int height, const std::string& windowTitle, float des
     while (glGetError() != GL_NO_ERROR)
         ;
 
-    // Set Window Icon
-    GLFWimage icons[1];
-    icons[0].pixels = stbi_load(IconPath::iconPath.c_str(), &icons[0].width, &icons[0].height, 0, 4);
-
-    glfwSetWindowIcon(m_window, 1, icons);
-    stbi_image_free(icons[0].pixels);
-
-    // Set up cursor
-    GLFWimage cursorImage;
-    cursorImage.pixels = stbi_load(CursorPath::cursorPath.c_str(),
-                                   &cursorImage.width,
-                                   &cursorImage.height,
-                                   0,
-                                   4);
-    GLFWcursor* cursor = glfwCreateCursor(&cursorImage, 0, 0);
-    glfwSetCursor(m_window, cursor);
+    GLFWcursor* cursor = nullptr;
+    if (!m_headless) {
+        // Set Window Icon
+        GLFWimage icons[1];
+        icons[0].pixels = stbi_load(IconPath::iconPath.c_str(),
+                                    &icons[0].width,
+                                    &icons[0].height,
+                                    0,
+                                    4);
+
+        glfwSetWindowIcon(m_window, 1, icons);
+        stbi_image_free(icons[0].pixels);
+
+        // Set up cursor
+        GLFWimage cursorImage;
+        cursorImage.pixels = stbi_load(CursorPath::cursorPath.c_str(),
+                                       &cursorImage.width,
+                                       &cursorImage.height,
+                                       0,
+                                       4);
+        cursor = glfwCreateCursor(&cursorImage, 0, 0);
+        glfwSetCursor(m_window, cursor);
+    }
 
     try {
-        // Wait until m_monitor refreshes before swapping front and back buffers.
-        // To prevent tearing artifacts.
-        glfwSwapInterval(1);
+        // With --vsync, wait until m_monitor refreshes before swapping front and back buffers.
+        // Otherwise the frame scheduler paces the loop.
+        if (m_window != nullptr)
+            glfwSwapInterval(m_vsync && !m_headless ? 1 : 0);
 
         // Call client-defined startup code.
         init();
 
-        // steady_clock::time_point frameStartTime;
-        m_game_clock = std::chrono::high_resolution_clock::now();
-        std::clock_t start;
-        float duration;
+        int frame {0};
+        m_frame_scheduler.start();
 
         // Main Program Loop:
-        while (!glfwWindowShouldClose(m_window)) {
-            // Lap
-            start = std::clock();
-
-            glfwPollEvents();
+        while (!shouldClose(frame)) {
+            if (m_window != nullptr)
+                glfwPollEvents();
 
             if (!m_paused) {
                 // Apply application-specific logic
@@ -393,22 +540,24 @@ GameWindow::run(int width, int height, const std::string& windowTitle, float des
                 glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
                 draw();
 
+                if (m_headless && !m_dump_frames_dir.empty())
+                    dumpFrame(frame);
+
                 // In case of a window resize, get new framebuffer dimensions.
-                glfwGetFramebufferSize(m_window, &m_framebufferWidth, &m_framebufferHeight);
+                if (m_window != nullptr)
+                    glfwGetFramebufferSize(m_window, &m_framebufferWidth, &m_framebufferHeight);
 
                 // Finally, blast everything to the screen.
-                glfwSwapBuffers(m_window);
-            }
-
-            duration = (std::clock() - start) / static_cast<float>(CLOCKS_PER_SEC);
-
-            if (FPS::frameDelay > duration) {
-                Sleep(FPS::frameDelay - duration);
+                swapBuffers();
             }
 
-            m_game_delta_time = (std::clock() - start) / static_cast<float>(CLOCKS_PER_SEC);
+            // Wall clock time of the whole frame, waiting included
+            m_game_delta_time = m_frame_scheduler.endFrame();
+            frame++;
         }
 
+        m_frame_scheduler.printStats();
+
     } catch (const std::exception& e) {
         std::cerr << "Exception Thrown: ";
         std::cerr << e.what() << std::endl;
@@ -417,8 +566,13 @@ GameWindow::run(int width, int height, const std::string& windowTitle, float des
     }
 
     cleanup();
-    glfwDestroyCursor(cursor);
-    glfwDestroyWindow(m_window);
+    if (cursor != nullptr)
+        glfwDestroyCursor(cursor);
+    if (m_window != nullptr)
+        glfwDestroyWindow(m_window);
+#if (HEADLESS_EGL)
+    m_headless_context.destroy();
+#endif
 }
 
 //----------------------------------------------------------------------------------------
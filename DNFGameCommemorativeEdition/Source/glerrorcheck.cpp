@@ -1,7 +1,8 @@
 #include "glerrorcheck.hpp"
 #include "exception.hpp"
 
-#include <GL/glew.h>
+#include "glshim.hpp"
+
 #include <GLFW/glfw3.h>
 
 #include <glm.hpp>
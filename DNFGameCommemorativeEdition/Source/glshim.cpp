@@ -0,0 +1,1126 @@
+#define GL_SHIM_IMPLEMENTATION
+#include "glshim.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if (GL_SHIM_RECORD_ONLY)
+// Record only builds have no GL behind them, a call is only named for its type and the
+// pass-through branches are never taken
+template<typename T>
+static T
+noPassThrough()
+{
+    std::abort();
+}
+#define GL_PASS(call) noPassThrough<decltype(call)>()
+#else
+#define GL_PASS(call) (call)
+#endif
+
+// A uniform or attribute found in a program's sources
+struct RecordedVariable
+{
+    std::string name;
+    GLint location;
+    // Array length, 1 for plain variables
+    GLint size;
+};
+
+struct RecordedProgram
+{
+    std::vector<GLuint> shaders;
+    std::vector<RecordedVariable> uniforms;
+    std::vector<RecordedVariable> attribs;
+};
+
+// clang-format off
+
+static GLShim::Mode m_mode {GL_SHIM_RECORD_ONLY ? GLShim::Mode::Record
+                                                 : GLShim::Mode::PassThrough};
+
+static GLShim::Stats m_frame_stats;
+static GLShim::Stats m_last_frame_stats;
+
+// Record only
+static GLuint m_next_name {1};
+static std::unordered_map<GLenum, GLuint> m_bound_buffers;
+static std::unordered_map<GLuint, std::vector<unsigned char>> m_buffer_storage;
+static std::unordered_map<GLuint, GLenum> m_shader_types;
+static std::unordered_map<GLuint, std::string> m_shader_sources;
+static std::unordered_map<GLuint, RecordedProgram> m_programs;
+
+static const GLint m_record_max_texture_size {16384};
+
+// clang-format on
+
+static bool
+recording()
+{
+    return m_mode == GLShim::Mode::Record;
+}
+
+static void
+generateNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; i++) {
+        names[i] = m_next_name++;
+    }
+}
+
+static size_t
+pixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type)
+{
+    size_t components {4};
+    switch (format) {
+    case GL_RED:
+        components = 1;
+        break;
+    case GL_RG:
+        components = 2;
+        break;
+    case GL_RGB:
+        components = 3;
+        break;
+    default:
+        break;
+    }
+
+    size_t componentSize = type == GL_FLOAT ? 4 : 1;
+
+    return static_cast<size_t>(width) * height * components * componentSize;
+}
+
+static std::vector<unsigned char>&
+boundBufferStorage(GLenum target)
+{
+    return m_buffer_storage[m_bound_buffers[target]];
+}
+
+static void
+copyName(const std::string& source, GLsizei bufSize, GLsizei* length, GLchar* name)
+{
+    if (bufSize <= 0)
+        return;
+
+    GLsizei count = std::min(static_cast<GLsizei>(source.size()), bufSize - 1);
+    std::memcpy(name, source.data(), count);
+    name[count] = '\0';
+
+    if (length != nullptr)
+        *length = count;
+}
+
+/*
+ * Collect the uniforms of every stage and the attributes of the vertex stage, in the order
+ * they are declared. Uniform blocks are not reported, same as GL.
+ */
+static void
+reflectProgram(RecordedProgram& program)
+{
+    static const std::regex uniformDecl(R"(^\s*uniform\s+\w+\s+(\w+)\s*(\[\s*(\d+)\s*\])?)");
+    static const std::regex attribDecl(R"(^\s*(layout\s*\([^)]*\)\s*)?in\s+(\w+)\s+(\w+))");
+
+    program.uniforms.clear();
+    program.attribs.clear();
+
+    GLint uniformLocation {0};
+    GLint attribLocation {0};
+
+    for (GLuint shader : program.shaders) {
+        std::istringstream source(m_shader_sources[shader]);
+        bool vertexStage = m_shader_types[shader] == GL_VERTEX_SHADER;
+
+        std::string line;
+        std::smatch match;
+        while (std::getline(source, line)) {
+            if (std::regex_search(line, match, uniformDecl)) {
+                std::string name = match[1].str();
+                GLint size = match[3].matched ? std::stoi(match[3].str()) : 1;
+
+                bool known = std::any_of(program.uniforms.begin(),
+                                         program.uniforms.end(),
+                                         [&](const RecordedVariable& uniform) {
+                                             return uniform.name == name;
+                                         });
+                if (!known) {
+                    program.uniforms.push_back({name, uniformLocation, size});
+                    uniformLocation += size;
+                }
+            } else if (vertexStage && std::regex_search(line, match, attribDecl)) {
+                // Matrices take one location per column
+                std::string type = match[2].str();
+                GLint slots = type == "mat4" ? 4 : (type == "mat3" ? 3 : 1);
+
+                program.attribs.push_back({match[3].str(), attribLocation, 1});
+                attribLocation += slots;
+            }
+        }
+    }
+}
+
+static GLint
+findLocation(const std::vector<RecordedVariable>& variables, const std::string& name)
+{
+    // "name[i]" addresses element i of an array
+    std::string baseName = name;
+    GLint element {0};
+
+    auto bracket = name.find('[');
+    if (bracket != std::string::npos) {
+        baseName = name.substr(0, bracket);
+        element = std::atoi(name.c_str() + bracket + 1);
+    }
+
+    for (const auto& variable : variables) {
+        if (variable.name == baseName && element < variable.size)
+            return variable.location + element;
+    }
+
+    return -1;
+}
+
+void
+GLShim::setMode(Mode mode)
+{
+#if (GL_SHIM_RECORD_ONLY)
+    if (mode == Mode::PassThrough) {
+        std::cerr << "GLShim: built with GL_SHIM_RECORD_ONLY, staying in Record" << std::endl;
+        return;
+    }
+#endif
+
+    m_mode = mode;
+}
+
+GLShim::Mode
+GLShim::getMode()
+{
+    return m_mode;
+}
+
+void
+GLShim::beginFrame()
+{
+    m_last_frame_stats = m_frame_stats;
+    m_frame_stats = Stats();
+}
+
+const GLShim::Stats&
+GLShim::getStats()
+{
+    return m_last_frame_stats;
+}
+
+void
+GLShim::printStats()
+{
+    std::cout << "GLShim (last frame) draw calls: " << m_last_frame_stats.drawCalls
+              << ", binds: " << m_last_frame_stats.binds
+              << ", program switches: " << m_last_frame_stats.programSwitches
+              << ", uniform uploads: " << m_last_frame_stats.uniformUploads
+              << ", state changes: " << m_last_frame_stats.stateChanges
+              << ", buffer bytes: " << m_last_frame_stats.bufferUploadBytes
+              << ", texture bytes: " << m_last_frame_stats.textureUploadBytes << std::endl;
+}
+
+void
+GLShim::countMappedUpload(size_t bytes)
+{
+    m_frame_stats.bufferUploadBytes += bytes;
+}
+
+//----------------------------------------------------------------------------------------
+// Draw
+
+void
+GLShim::drawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    m_frame_stats.drawCalls++;
+
+    if (!recording())
+        GL_PASS(glDrawArrays(mode, first, count));
+}
+
+void
+GLShim::drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    m_frame_stats.drawCalls++;
+
+    if (!recording())
+        GL_PASS(glDrawArraysInstanced(mode, first, count, instances));
+}
+
+//----------------------------------------------------------------------------------------
+// Binds
+
+void
+GLShim::bindBuffer(GLenum target, GLuint buffer)
+{
+    m_frame_stats.binds++;
+
+    if (recording())
+        m_bound_buffers[target] = buffer;
+    else
+        GL_PASS(glBindBuffer(target, buffer));
+}
+
+void
+GLShim::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    m_frame_stats.binds++;
+
+    if (recording())
+        m_bound_buffers[target] = buffer;
+    else
+        GL_PASS(glBindBufferBase(target, index, buffer));
+}
+
+void
+GLShim::bindVertexArray(GLuint array)
+{
+    m_frame_stats.binds++;
+
+    if (!recording())
+        GL_PASS(glBindVertexArray(array));
+}
+
+void
+GLShim::bindTexture(GLenum target, GLuint texture)
+{
+    m_frame_stats.binds++;
+
+    if (!recording())
+        GL_PASS(glBindTexture(target, texture));
+}
+
+void
+GLShim::bindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    m_frame_stats.binds++;
+
+    if (!recording())
+        GL_PASS(glBindFramebuffer(target, framebuffer));
+}
+
+void
+GLShim::useProgram(GLuint program)
+{
+    m_frame_stats.programSwitches++;
+
+    if (!recording())
+        GL_PASS(glUseProgram(program));
+}
+
+//----------------------------------------------------------------------------------------
+// Uniforms
+
+void
+GLShim::uniform1i(GLint location, GLint value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform1i(location, value));
+}
+
+void
+GLShim::uniform1f(GLint location, GLfloat value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform1f(location, value));
+}
+
+void
+GLShim::uniform1iv(GLint location, GLsizei count, const GLint* value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform1iv(location, count, value));
+}
+
+void
+GLShim::uniform2fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform2fv(location, count, value));
+}
+
+void
+GLShim::uniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform3fv(location, count, value));
+}
+
+void
+GLShim::uniform4fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniform4fv(location, count, value));
+}
+
+void
+GLShim::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    m_frame_stats.uniformUploads++;
+
+    if (!recording())
+        GL_PASS(glUniformMatrix4fv(location, count, transpose, value));
+}
+
+void
+GLShim::uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint binding)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glUniformBlockBinding(program, blockIndex, binding));
+}
+
+//----------------------------------------------------------------------------------------
+// Buffers and vertex arrays
+
+void
+GLShim::genBuffers(GLsizei n, GLuint* buffers)
+{
+    if (recording())
+        generateNames(n, buffers);
+    else
+        GL_PASS(glGenBuffers(n, buffers));
+}
+
+void
+GLShim::deleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    if (recording()) {
+        for (GLsizei i = 0; i < n; i++) {
+            m_buffer_storage.erase(buffers[i]);
+        }
+    } else {
+        GL_PASS(glDeleteBuffers(n, buffers));
+    }
+}
+
+void
+GLShim::bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    // Allocation only (orphaning) moves no data
+    if (data != nullptr)
+        m_frame_stats.bufferUploadBytes += static_cast<size_t>(size);
+
+    if (recording())
+        boundBufferStorage(target).resize(static_cast<size_t>(size));
+    else
+        GL_PASS(glBufferData(target, size, data, usage));
+}
+
+void
+GLShim::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    m_frame_stats.bufferUploadBytes += static_cast<size_t>(size);
+
+    if (!recording())
+        GL_PASS(glBufferSubData(target, offset, size, data));
+}
+
+void
+GLShim::bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+{
+    if (data != nullptr)
+        m_frame_stats.bufferUploadBytes += static_cast<size_t>(size);
+
+    if (recording())
+        boundBufferStorage(target).resize(static_cast<size_t>(size));
+    else
+        GL_PASS(glBufferStorage(target, size, data, flags));
+}
+
+void*
+GLShim::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    if (!recording())
+        return GL_PASS(glMapBufferRange(target, offset, length, access));
+
+    auto& storage = boundBufferStorage(target);
+    if (storage.size() < static_cast<size_t>(offset + length))
+        storage.resize(static_cast<size_t>(offset + length));
+
+    return storage.data() + offset;
+}
+
+GLboolean
+GLShim::unmapBuffer(GLenum target)
+{
+    if (recording())
+        return GL_TRUE;
+
+    return GL_PASS(glUnmapBuffer(target));
+}
+
+void
+GLShim::genVertexArrays(GLsizei n, GLuint* arrays)
+{
+    if (recording())
+        generateNames(n, arrays);
+    else
+        GL_PASS(glGenVertexArrays(n, arrays));
+}
+
+void
+GLShim::deleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    if (!recording())
+        GL_PASS(glDeleteVertexArrays(n, arrays));
+}
+
+void
+GLShim::enableVertexAttribArray(GLuint index)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glEnableVertexAttribArray(index));
+}
+
+void
+GLShim::vertexAttribPointer(GLuint index,
+                            GLint size,
+                            GLenum type,
+                            GLboolean normalized,
+                            GLsizei stride,
+                            const void* pointer)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glVertexAttribPointer(index, size, type, normalized, stride, pointer));
+}
+
+void
+GLShim::vertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glVertexAttribDivisor(index, divisor));
+}
+
+//----------------------------------------------------------------------------------------
+// Textures and framebuffers
+
+void
+GLShim::genTextures(GLsizei n, GLuint* textures)
+{
+    if (recording())
+        generateNames(n, textures);
+    else
+        GL_PASS(glGenTextures(n, textures));
+}
+
+void
+GLShim::deleteTextures(GLsizei n, const GLuint* textures)
+{
+    if (!recording())
+        GL_PASS(glDeleteTextures(n, textures));
+}
+
+void
+GLShim::activeTexture(GLenum texture)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glActiveTexture(texture));
+}
+
+void
+GLShim::texImage2D(GLenum target,
+                   GLint level,
+                   GLint internalFormat,
+                   GLsizei width,
+                   GLsizei height,
+                   GLint border,
+                   GLenum format,
+                   GLenum type,
+                   const void* pixels)
+{
+    if (pixels != nullptr)
+        m_frame_stats.textureUploadBytes += pixelBytes(width, height, format, type);
+
+    if (!recording())
+        GL_PASS(glTexImage2D(
+            target, level, internalFormat, width, height, border, format, type, pixels));
+}
+
+void
+GLShim::texParameteri(GLenum target, GLenum name, GLint param)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glTexParameteri(target, name, param));
+}
+
+void
+GLShim::texBuffer(GLenum target, GLenum internalFormat, GLuint buffer)
+{
+    m_frame_stats.binds++;
+
+    if (!recording())
+        GL_PASS(glTexBuffer(target, internalFormat, buffer));
+}
+
+void
+GLShim::generateMipmap(GLenum target)
+{
+    if (!recording())
+        GL_PASS(glGenerateMipmap(target));
+}
+
+void
+GLShim::pixelStorei(GLenum name, GLint param)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glPixelStorei(name, param));
+}
+
+void
+GLShim::genFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    if (recording())
+        generateNames(n, framebuffers);
+    else
+        GL_PASS(glGenFramebuffers(n, framebuffers));
+}
+
+void
+GLShim::deleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    if (!recording())
+        GL_PASS(glDeleteFramebuffers(n, framebuffers));
+}
+
+void
+GLShim::framebufferTexture2D(GLenum target,
+                             GLenum attachment,
+                             GLenum texTarget,
+                             GLuint texture,
+                             GLint level)
+{
+    if (!recording())
+        GL_PASS(glFramebufferTexture2D(target, attachment, texTarget, texture, level));
+}
+
+GLenum
+GLShim::checkFramebufferStatus(GLenum target)
+{
+    if (recording())
+        return GL_FRAMEBUFFER_COMPLETE;
+
+    return GL_PASS(glCheckFramebufferStatus(target));
+}
+
+//----------------------------------------------------------------------------------------
+// Fixed state
+
+void
+GLShim::enable(GLenum cap)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glEnable(cap));
+}
+
+void
+GLShim::disable(GLenum cap)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glDisable(cap));
+}
+
+void
+GLShim::depthMask(GLboolean flag)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glDepthMask(flag));
+}
+
+void
+GLShim::depthFunc(GLenum func)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glDepthFunc(func));
+}
+
+void
+GLShim::depthRange(GLclampd zNear, GLclampd zFar)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glDepthRange(zNear, zFar));
+}
+
+void
+GLShim::blendFunc(GLenum sFactor, GLenum dFactor)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glBlendFunc(sFactor, dFactor));
+}
+
+void
+GLShim::blendFuncSeparate(GLenum sFactor, GLenum dFactor, GLenum sFactorAlpha, GLenum dFactorAlpha)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glBlendFuncSeparate(sFactor, dFactor, sFactorAlpha, dFactorAlpha));
+}
+
+void
+GLShim::cullFace(GLenum mode)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glCullFace(mode));
+}
+
+void
+GLShim::frontFace(GLenum mode)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glFrontFace(mode));
+}
+
+void
+GLShim::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glViewport(x, y, width, height));
+}
+
+void
+GLShim::clear(GLbitfield mask)
+{
+    if (!recording())
+        GL_PASS(glClear(mask));
+}
+
+void
+GLShim::clearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glClearColor(red, green, blue, alpha));
+}
+
+void
+GLShim::clearDepth(GLclampd depth)
+{
+    m_frame_stats.stateChanges++;
+
+    if (!recording())
+        GL_PASS(glClearDepth(depth));
+}
+
+void
+GLShim::clearBufferfv(GLenum buffer, GLint drawBuffer, const GLfloat* value)
+{
+    if (!recording())
+        GL_PASS(glClearBufferfv(buffer, drawBuffer, value));
+}
+
+//----------------------------------------------------------------------------------------
+// Shaders and programs
+
+GLuint
+GLShim::createShader(GLenum type)
+{
+    if (!recording())
+        return GL_PASS(glCreateShader(type));
+
+    GLuint shader = m_next_name++;
+    m_shader_types[shader] = type;
+
+    return shader;
+}
+
+void
+GLShim::deleteShader(GLuint shader)
+{
+    if (!recording()) {
+        GL_PASS(glDeleteShader(shader));
+        return;
+    }
+
+    m_shader_types.erase(shader);
+    m_shader_sources.erase(shader);
+}
+
+void
+GLShim::shaderSource(GLuint shader,
+                     GLsizei count,
+                     const GLchar* const* strings,
+                     const GLint* lengths)
+{
+    if (!recording()) {
+        GL_PASS(glShaderSource(shader, count, strings, lengths));
+        return;
+    }
+
+    std::string& source = m_shader_sources[shader];
+    source.clear();
+
+    for (GLsizei i = 0; i < count; i++) {
+        if (lengths != nullptr && lengths[i] >= 0)
+            source.append(strings[i], lengths[i]);
+        else
+            source.append(strings[i]);
+    }
+}
+
+void
+GLShim::compileShader(GLuint shader)
+{
+    if (!recording())
+        GL_PASS(glCompileShader(shader));
+}
+
+void
+GLShim::getShaderiv(GLuint shader, GLenum name, GLint* params)
+{
+    if (!recording()) {
+        GL_PASS(glGetShaderiv(shader, name, params));
+        return;
+    }
+
+    *params = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void
+GLShim::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* log)
+{
+    if (recording())
+        copyName("", bufSize, length, log);
+    else
+        GL_PASS(glGetShaderInfoLog(shader, bufSize, length, log));
+}
+
+GLuint
+GLShim::createProgram()
+{
+    if (!recording())
+        return GL_PASS(glCreateProgram());
+
+    GLuint program = m_next_name++;
+    m_programs[program] = RecordedProgram();
+
+    return program;
+}
+
+void
+GLShim::deleteProgram(GLuint program)
+{
+    if (recording())
+        m_programs.erase(program);
+    else
+        GL_PASS(glDeleteProgram(program));
+}
+
+void
+GLShim::attachShader(GLuint program, GLuint shader)
+{
+    if (recording())
+        m_programs[program].shaders.push_back(shader);
+    else
+        GL_PASS(glAttachShader(program, shader));
+}
+
+void
+GLShim::linkProgram(GLuint program)
+{
+    if (recording())
+        reflectProgram(m_programs[program]);
+    else
+        GL_PASS(glLinkProgram(program));
+}
+
+void
+GLShim::getProgramiv(GLuint program, GLenum name, GLint* params)
+{
+    if (!recording()) {
+        GL_PASS(glGetProgramiv(program, name, params));
+        return;
+    }
+
+    const RecordedProgram& recorded = m_programs[program];
+
+    // Longest name, with room for "[0]" and the terminator
+    auto maxNameLength = [](const std::vector<RecordedVariable>& variables) {
+        GLint length {0};
+        for (const auto& variable : variables) {
+            length = std::max(length, static_cast<GLint>(variable.name.size()) + 4);
+        }
+        return length;
+    };
+
+    switch (name) {
+    case GL_LINK_STATUS:
+        *params = GL_TRUE;
+        break;
+    case GL_ACTIVE_UNIFORMS:
+        *params = static_cast<GLint>(recorded.uniforms.size());
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        *params = maxNameLength(recorded.uniforms);
+        break;
+    case GL_ACTIVE_ATTRIBUTES:
+        *params = static_cast<GLint>(recorded.attribs.size());
+        break;
+    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        *params = maxNameLength(recorded.attribs);
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+void
+GLShim::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* log)
+{
+    if (recording())
+        copyName("", bufSize, length, log);
+    else
+        GL_PASS(glGetProgramInfoLog(program, bufSize, length, log));
+}
+
+void
+GLShim::getActiveUniform(GLuint program,
+                         GLuint index,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLint* size,
+                         GLenum* type,
+                         GLchar* name)
+{
+    if (!recording()) {
+        GL_PASS(glGetActiveUniform(program, index, bufSize, length, size, type, name));
+        return;
+    }
+
+    // The declared type is not kept, nothing reads it back
+    const RecordedVariable& uniform = m_programs[program].uniforms.at(index);
+    *size = uniform.size;
+    *type = GL_FLOAT;
+
+    copyName(uniform.size > 1 ? uniform.name + "[0]" : uniform.name, bufSize, length, name);
+}
+
+void
+GLShim::getActiveAttrib(GLuint program,
+                        GLuint index,
+                        GLsizei bufSize,
+                        GLsizei* length,
+                        GLint* size,
+                        GLenum* type,
+                        GLchar* name)
+{
+    if (!recording()) {
+        GL_PASS(glGetActiveAttrib(program, index, bufSize, length, size, type, name));
+        return;
+    }
+
+    const RecordedVariable& attrib = m_programs[program].attribs.at(index);
+    *size = attrib.size;
+    *type = GL_FLOAT;
+
+    copyName(attrib.name, bufSize, length, name);
+}
+
+GLint
+GLShim::getUniformLocation(GLuint program, const GLchar* name)
+{
+    if (recording())
+        return findLocation(m_programs[program].uniforms, name);
+
+    return GL_PASS(glGetUniformLocation(program, name));
+}
+
+GLint
+GLShim::getAttribLocation(GLuint program, const GLchar* name)
+{
+    if (recording())
+        return findLocation(m_programs[program].attribs, name);
+
+    return GL_PASS(glGetAttribLocation(program, name));
+}
+
+GLuint
+GLShim::getUniformBlockIndex(GLuint program, const GLchar* blockName)
+{
+    if (!recording())
+        return GL_PASS(glGetUniformBlockIndex(program, blockName));
+
+    // Every program here declares at most one block
+    const std::regex blockDecl("uniform\\s+" + std::string(blockName) + "\\s*\\{");
+    for (GLuint shader : m_programs[program].shaders) {
+        if (std::regex_search(m_shader_sources[shader], blockDecl))
+            return 0;
+    }
+
+    return GL_INVALID_INDEX;
+}
+
+//----------------------------------------------------------------------------------------
+// Sync and queries
+
+GLsync
+GLShim::fenceSync(GLenum condition, GLbitfield flags)
+{
+    if (!recording())
+        return GL_PASS(glFenceSync(condition, flags));
+
+    return reinterpret_cast<GLsync>(static_cast<uintptr_t>(m_next_name++));
+}
+
+GLenum
+GLShim::clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    if (recording())
+        return GL_ALREADY_SIGNALED;
+
+    return GL_PASS(glClientWaitSync(sync, flags, timeout));
+}
+
+void
+GLShim::deleteSync(GLsync sync)
+{
+    if (!recording())
+        GL_PASS(glDeleteSync(sync));
+}
+
+void
+GLShim::finish()
+{
+    if (!recording())
+        GL_PASS(glFinish());
+}
+
+GLenum
+GLShim::getError()
+{
+    if (recording())
+        return GL_NO_ERROR;
+
+    return GL_PASS(glGetError());
+}
+
+void
+GLShim::getIntegerv(GLenum name, GLint* data)
+{
+    if (!recording()) {
+        GL_PASS(glGetIntegerv(name, data));
+        return;
+    }
+
+    switch (name) {
+    case GL_VIEWPORT:
+        std::fill(data, data + 4, 0);
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *data = m_record_max_texture_size;
+        break;
+    case GL_MAJOR_VERSION:
+    case GL_MINOR_VERSION:
+        *data = 3;
+        break;
+    default:
+        *data = 0;
+        break;
+    }
+}
+
+const GLubyte*
+GLShim::getString(GLenum name)
+{
+    if (!recording())
+        return GL_PASS(glGetString(name));
+
+    switch (name) {
+    case GL_VERSION:
+        return reinterpret_cast<const GLubyte*>("3.3 GLShim");
+    case GL_SHADING_LANGUAGE_VERSION:
+        return reinterpret_cast<const GLubyte*>("3.30");
+    default:
+        return reinterpret_cast<const GLubyte*>("GLShim");
+    }
+}
+
+const GLubyte*
+GLShim::getStringi(GLenum name, GLuint index)
+{
+    if (!recording())
+        return GL_PASS(glGetStringi(name, index));
+
+    return reinterpret_cast<const GLubyte*>("");
+}
+
+bool
+GLShim::hasBufferStorage()
+{
+    if (recording())
+        return true;
+
+    return GL_PASS(GLEW_ARB_buffer_storage) != GL_FALSE;
+}
+
+void
+GLShim::readPixels(GLint x,
+                   GLint y,
+                   GLsizei width,
+                   GLsizei height,
+                   GLenum format,
+                   GLenum type,
+                   void* pixels)
+{
+    if (recording())
+        std::memset(pixels, 0, pixelBytes(width, height, format, type));
+    else
+        GL_PASS(glReadPixels(x, y, width, height, format, type, pixels));
+}
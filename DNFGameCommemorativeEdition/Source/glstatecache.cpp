@@ -0,0 +1,191 @@
+#include "glstatecache.hpp"
+
+#include <iostream>
+#include <unordered_map>
+
+// A tracked value and whether GL is known to hold it
+template<typename T>
+struct CachedState
+{
+    T value {};
+    bool known {false};
+};
+
+static std::unordered_map<GLenum, CachedState<bool>> m_caps;
+static CachedState<GLboolean> m_depth_mask;
+static CachedState<GLenum> m_depth_func;
+static CachedState<GLenum> m_blend_src;
+static CachedState<GLenum> m_blend_dst;
+static bool m_premultiplied_target {false};
+static CachedState<GLuint> m_program;
+static CachedState<GLuint> m_texture_2d[GLStateCache::maxTextureUnits];
+static CachedState<GLuint> m_texture_buffer[GLStateCache::maxTextureUnits];
+static CachedState<GLuint> m_active_texture_unit;
+
+static GLStateCache::Stats m_frame_stats;
+static GLStateCache::Stats m_last_frame_stats;
+
+/*
+ * Returns true if the call has to reach GL, and records the new value.
+ */
+template<typename T>
+static bool
+update(CachedState<T>& state, const T& value)
+{
+    if (state.known && state.value == value) {
+        m_frame_stats.elided++;
+
+        return false;
+    }
+
+    state.value = value;
+    state.known = true;
+    m_frame_stats.issued++;
+
+    return true;
+}
+
+/*
+ * Each target has its own binding per unit, only the active unit is shared.
+ */
+static void
+bindTexture(CachedState<GLuint>* bindings, GLenum target, GLuint unit, GLuint texture)
+{
+    // Check the binding first, most calls do not need to switch units at all
+    if (bindings[unit].known && bindings[unit].value == texture) {
+        m_frame_stats.elided++;
+
+        return;
+    }
+
+    if (update(m_active_texture_unit, unit))
+        glActiveTexture(GL_TEXTURE0 + unit);
+
+    update(bindings[unit], texture);
+    glBindTexture(target, texture);
+}
+
+void
+GLStateCache::enable(GLenum cap)
+{
+    if (update(m_caps[cap], true))
+        glEnable(cap);
+}
+
+void
+GLStateCache::disable(GLenum cap)
+{
+    if (update(m_caps[cap], false))
+        glDisable(cap);
+}
+
+void
+GLStateCache::depthMask(GLboolean flag)
+{
+    if (update(m_depth_mask, flag))
+        glDepthMask(flag);
+}
+
+void
+GLStateCache::depthFunc(GLenum func)
+{
+    if (update(m_depth_func, func))
+        glDepthFunc(func);
+}
+
+void
+GLStateCache::blendFunc(GLenum sFactor, GLenum dFactor)
+{
+    if (m_blend_src.known && m_blend_dst.known && m_blend_src.value == sFactor
+        && m_blend_dst.value == dFactor) {
+        m_frame_stats.elided++;
+
+        return;
+    }
+
+    m_blend_src = CachedState<GLenum> {sFactor, true};
+    m_blend_dst = CachedState<GLenum> {dFactor, true};
+    m_frame_stats.issued++;
+
+    if (m_premultiplied_target)
+        glBlendFuncSeparate(sFactor, dFactor, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    else
+        glBlendFunc(sFactor, dFactor);
+}
+
+void
+GLStateCache::setPremultipliedTarget(bool premultiplied)
+{
+    if (m_premultiplied_target == premultiplied)
+        return;
+
+    m_premultiplied_target = premultiplied;
+
+    // The alpha factors GL holds no longer match what the next blendFunc wants
+    m_blend_src.known = false;
+    m_blend_dst.known = false;
+}
+
+void
+GLStateCache::useProgram(GLuint program)
+{
+    if (update(m_program, program))
+        glUseProgram(program);
+}
+
+void
+GLStateCache::bindTexture2D(GLuint texture)
+{
+    bindTexture2D(0, texture);
+}
+
+void
+GLStateCache::bindTexture2D(GLuint unit, GLuint texture)
+{
+    bindTexture(m_texture_2d, GL_TEXTURE_2D, unit, texture);
+}
+
+void
+GLStateCache::bindTextureBuffer(GLuint unit, GLuint texture)
+{
+    bindTexture(m_texture_buffer, GL_TEXTURE_BUFFER, unit, texture);
+}
+
+void
+GLStateCache::onProgramDeleted(GLuint program)
+{
+    if (m_program.value == program)
+        m_program.known = false;
+}
+
+void
+GLStateCache::onTextureDeleted(GLuint texture)
+{
+    for (GLuint unit = 0; unit < maxTextureUnits; unit++) {
+        if (m_texture_2d[unit].value == texture)
+            m_texture_2d[unit].known = false;
+
+        if (m_texture_buffer[unit].value == texture)
+            m_texture_buffer[unit].known = false;
+    }
+}
+
+void
+GLStateCache::beginFrame()
+{
+    m_last_frame_stats = m_frame_stats;
+    m_frame_stats = Stats();
+}
+
+const GLStateCache::Stats&
+GLStateCache::getStats()
+{
+    return m_last_frame_stats;
+}
+
+void
+GLStateCache::printStats()
+{
+    std::cout << "GLStateCache (last frame) issued: " << m_last_frame_stats.issued
+              << ", elided: " << m_last_frame_stats.elided << std::endl;
+}
@@ -0,0 +1,139 @@
+#include "headlesscontext.hpp"
+
+#if (HEADLESS_EGL)
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <iostream>
+
+// clang-format off
+
+static const EGLint m_config_attributes[] {
+    EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+    EGL_RED_SIZE,           8,
+    EGL_GREEN_SIZE,         8,
+    EGL_BLUE_SIZE,          8,
+    EGL_ALPHA_SIZE,         8,
+    EGL_DEPTH_SIZE,         24,
+    EGL_NONE
+};
+
+static const EGLint m_context_attributes[] {
+    EGL_CONTEXT_MAJOR_VERSION,              3,
+    EGL_CONTEXT_MINOR_VERSION,              3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK,        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE,  EGL_TRUE,
+    EGL_NONE
+};
+
+// clang-format on
+
+static EGLDisplay getSurfacelessDisplay();
+
+//----------------------------------------------------------------------------------------
+HeadlessContext::HeadlessContext()
+    : m_display(EGL_NO_DISPLAY)
+    , m_surface(EGL_NO_SURFACE)
+    , m_context(EGL_NO_CONTEXT)
+{}
+
+//----------------------------------------------------------------------------------------
+HeadlessContext::~HeadlessContext()
+{
+    destroy();
+}
+
+//----------------------------------------------------------------------------------------
+bool
+HeadlessContext::create(int width, int height)
+{
+    EGLDisplay display = getSurfacelessDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        std::cerr << "EGL display initialisation failed: 0x" << std::hex << eglGetError()
+                  << std::dec << std::endl;
+        return false;
+    }
+    m_display = display;
+
+    EGLConfig config;
+    EGLint configCount {0};
+    if (!eglChooseConfig(display, m_config_attributes, &config, 1, &configCount)
+        || configCount == 0) {
+        std::cerr << "No EGL config with an RGBA8 depth24 OpenGL pbuffer" << std::endl;
+        destroy();
+        return false;
+    }
+
+    const EGLint surfaceAttributes[] {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+    m_surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (m_surface == EGL_NO_SURFACE) {
+        std::cerr << "EGL pbuffer creation failed: 0x" << std::hex << eglGetError() << std::dec
+                  << std::endl;
+        destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    m_context = eglCreateContext(display, config, EGL_NO_CONTEXT, m_context_attributes);
+    if (m_context == EGL_NO_CONTEXT || !eglMakeCurrent(display, m_surface, m_surface, m_context)) {
+        std::cerr << "EGL OpenGL 3.3 core context creation failed: 0x" << std::hex
+                  << eglGetError() << std::dec << std::endl;
+        destroy();
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------
+void
+HeadlessContext::destroy()
+{
+    if (m_display == EGL_NO_DISPLAY)
+        return;
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_context != EGL_NO_CONTEXT)
+        eglDestroyContext(m_display, m_context);
+    if (m_surface != EGL_NO_SURFACE)
+        eglDestroySurface(m_display, m_surface);
+    eglTerminate(m_display);
+
+    m_display = EGL_NO_DISPLAY;
+    m_surface = EGL_NO_SURFACE;
+    m_context = EGL_NO_CONTEXT;
+}
+
+//----------------------------------------------------------------------------------------
+void
+HeadlessContext::swapBuffers()
+{
+    if (m_surface != EGL_NO_SURFACE)
+        eglSwapBuffers(m_display, m_surface);
+}
+
+//----------------------------------------------------------------------------------------
+static EGLDisplay
+getSurfacelessDisplay()
+{
+    // Client extensions are queried without a display
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    if (extensions != nullptr && getPlatformDisplay != nullptr
+        && std::strstr(extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                                EGL_DEFAULT_DISPLAY,
+                                                nullptr);
+        if (display != EGL_NO_DISPLAY)
+            return display;
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+#endif
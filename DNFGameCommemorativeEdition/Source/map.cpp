@@ -1,7 +1,8 @@
 ﻿#include "map.hpp"
 #include "constant.hpp"
-#include "floor.hpp"
-#include "background.hpp"
+#include "tilemap.hpp"
+#include "parallaxlayer.hpp"
+#include "staticlayer.hpp"
 #include "floorobj.hpp"
 
 // clang-format off
@@ -29,10 +30,10 @@ const std::vector<std::vector<std::vector<int>>> scene_two_floor_tiles = {
     {{0, 4}, {0}, {0, 2}, {0}, {0}, {0, 1}, {0}, {0, 4}}
 };
 
-// Scene background tiles
-// 0 for far, 1 for mid
-const std::vector<std::vector<std::vector<int>>> scene_background_tiles = {
-    {{0, 1}, {0, 1}, {0, 1}, {0, 1}}
+// Scene background layers, back to front
+const std::vector<ParallaxLayer::LayerType> scene_background_layers = {
+    ParallaxLayer::LayerType::Far,
+    ParallaxLayer::LayerType::Mid
 };
 
 // clang-format on
@@ -46,6 +47,7 @@ Map::Map(ShaderProgram* shader, NPC* npc, GLfloat width, GLfloat height)
     , m_map_boundary(glm::vec4(0.0f))
     , m_map_top_offset(0.0f)
     , m_map_right_offset(0.0f)
+    , m_static_layer(nullptr)
 {}
 
 Map::~Map() {}
@@ -59,52 +61,17 @@ Map::initSceneOneMap()
 
     m_map_boundary.z = 0.0f;
 
-    // Background tile
-    float rowNum = static_cast<float>(scene_background_tiles.size());
-    float colNum = static_cast<float>(scene_background_tiles[0].size());
+    // Background layers
+    initBackgroundLayers(StringContant::sceneOneBackgroundName);
 
-    for (size_t i = 0; i < rowNum; i++) {
-        for (size_t j = 0; j < colNum; j++) {
-            auto heightScale = (m_window_height * RatioContant::backgroundHeightScaleRatio)
-                               / rowNum;
-            auto upTranslation = (m_window_height
-                                  * (1.0f - RatioContant::backgroundHeightScaleRatio))
-                                 / rowNum;
-
-            for (size_t k = 0; k < scene_background_tiles[i][j].size(); k++) {
-                if (scene_background_tiles[i][j][k] == 0) {
-                    Background* farBack = new Background(StringContant::sceneOneBackgroundName
-                                                             + std::to_string(i + j + k),
-                                                         m_shader,
-                                                         0,
-                                                         heightScale,
-                                                         Background::BackgroundTextureType::Far);
-
-                    farBack->translate(
-                        glm::vec3(farBack->getTextureGeo().x * j, upTranslation * (i + 1), 0.0f));
-
-                    addChild(farBack);
-                } else if (scene_background_tiles[i][j][k] == 1) {
-                    Background* midBack = new Background(StringContant::sceneOneBackgroundName
-                                                             + std::to_string(i + j + k),
-                                                         m_shader,
-                                                         0,
-                                                         heightScale,
-                                                         Background::BackgroundTextureType::Mid);
-
-                    midBack->translate(
-                        glm::vec3(midBack->getTextureGeo().x * j, upTranslation * (i + 1), 0.0f));
-
-                    addChild(midBack);
-                }
-            }
-        }
-    }
+    // Floor tile, baked into one static mesh
+    TileMap* tileMap = new TileMap(StringContant::sceneOneFloorName, m_shader);
+    auto grassTile = TextureCache::acquire(TexturePath::grassTilePath);
+    auto roadTile = TextureCache::acquire(TexturePath::roadTilePath);
 
-    // Floor tile
     float totalMainFloorXTrans {0.0f}; // for floor obj to use
-    rowNum = static_cast<float>(scene_one_floor_tiles.size());
-    colNum = static_cast<float>(scene_one_floor_tiles[0].size());
+    float rowNum = static_cast<float>(scene_one_floor_tiles.size());
+    float colNum = static_cast<float>(scene_one_floor_tiles[0].size());
     m_map_boundary.x = (m_window_height * RatioContant::floorHeightScaleRatio)
                            * RatioContant::attachOffset
                        - m_map_top_offset;
@@ -116,33 +83,23 @@ Map::initSceneOneMap()
 
             for (size_t k = 0; k < scene_one_floor_tiles[i][j].size(); k++) {
                 if (scene_one_floor_tiles[i][j][k] == 0) {
-                    Floor* glassFloor = new Floor(StringContant::sceneOneFloorName
-                                                      + std::to_string(i + j + k),
-                                                  m_shader,
-                                                  0,
-                                                  heightScale,
-                                                  Floor::FloorTextureType::Grass);
+                    auto grassWidth = static_cast<float>(grassTile->getTextureWidth());
+                    auto grassHeight = heightScale;
 
                     if (i != rowNum - 1) {
-                        glassFloor->scale(glm::vec3(1.0f, RatioContant::attachOffset, 1.0f));
+                        grassHeight = grassHeight * RatioContant::attachOffset;
                     }
 
-                    totalMainFloorXTrans = glassFloor->getTextureGeo().x * j;
-                    glassFloor->translate(glm::vec3(totalMainFloorXTrans, heightScale * i, 0.0f));
-
-                    addChild(glassFloor);
+                    totalMainFloorXTrans = grassWidth * j;
+                    tileMap->addTile(glm::vec2(totalMainFloorXTrans, heightScale * i),
+                                     glm::vec2(grassWidth, grassHeight),
+                                     grassTile);
                 } else if (scene_one_floor_tiles[i][j][k] == 1) {
-                    Floor* roadFloor = new Floor(StringContant::sceneOneFloorName
-                                                     + std::to_string(i + j + k),
-                                                 m_shader,
-                                                 0,
-                                                 heightScale,
-                                                 Floor::FloorTextureType::Road);
+                    auto roadWidth = static_cast<float>(roadTile->getTextureWidth());
 
-                    roadFloor->translate(
-                        glm::vec3(roadFloor->getTextureGeo().x * j, heightScale * i, 0.0f));
-
-                    addChild(roadFloor);
+                    tileMap->addTile(glm::vec2(roadWidth * j, heightScale * i),
+                                     glm::vec2(roadWidth, heightScale),
+                                     roadTile);
                 }
                 // Floor obj
                 else if (scene_one_floor_tiles[i][j][k] == 2) {
@@ -191,10 +148,8 @@ Map::initSceneOneMap()
         }
     }
 
-    // No need to rearrange the drawing order, add first
-    for (auto i : m_floor_obj_layer_one_list) {
-        addChild(i);
-    }
+    tileMap->build();
+    addStaticContent(tileMap, StringContant::sceneOneStaticLayerName);
 
     m_map_boundary.w = m_map_boundary.w - m_map_right_offset;
 }
@@ -208,52 +163,16 @@ Map::initSceneTwoMap()
 
     m_map_boundary.z = 0.0f;
 
-    // Background tile
-    float rowNum = static_cast<float>(scene_background_tiles.size());
-    float colNum = static_cast<float>(scene_background_tiles[0].size());
+    // Background layers
+    initBackgroundLayers(StringContant::sceneTwoBackgroundName);
 
-    for (size_t i = 0; i < rowNum; i++) {
-        for (size_t j = 0; j < colNum; j++) {
-            auto heightScale = (m_window_height * RatioContant::backgroundHeightScaleRatio)
-                               / rowNum;
-            auto upTranslation = (m_window_height
-                                  * (1.0f - RatioContant::backgroundHeightScaleRatio))
-                                 / rowNum;
-
-            for (size_t k = 0; k < scene_background_tiles[i][j].size(); k++) {
-                if (scene_background_tiles[i][j][k] == 0) {
-                    Background* farBack = new Background(StringContant::sceneOneBackgroundName
-                                                             + std::to_string(i + j + k),
-                                                         m_shader,
-                                                         0,
-                                                         heightScale,
-                                                         Background::BackgroundTextureType::Far);
-
-                    farBack->translate(
-                        glm::vec3(farBack->getTextureGeo().x * j, upTranslation * (i + 1), 0.0f));
-
-                    addChild(farBack);
-                } else if (scene_background_tiles[i][j][k] == 1) {
-                    Background* midBack = new Background(StringContant::sceneOneBackgroundName
-                                                             + std::to_string(i + j + k),
-                                                         m_shader,
-                                                         0,
-                                                         heightScale,
-                                                         Background::BackgroundTextureType::Mid);
-
-                    midBack->translate(
-                        glm::vec3(midBack->getTextureGeo().x * j, upTranslation * (i + 1), 0.0f));
-
-                    addChild(midBack);
-                }
-            }
-        }
-    }
+    // Floor tile, baked into one static mesh
+    TileMap* tileMap = new TileMap(StringContant::sceneTwoFloorName, m_shader);
+    auto grassTile = TextureCache::acquire(TexturePath::grassTilePath);
 
-    // Floor tile
     float totalMainFloorXTrans {0.0f}; // for floor obj to use
-    rowNum = static_cast<float>(scene_two_floor_tiles.size());
-    colNum = static_cast<float>(scene_two_floor_tiles[0].size());
+    float rowNum = static_cast<float>(scene_two_floor_tiles.size());
+    float colNum = static_cast<float>(scene_two_floor_tiles[0].size());
     m_map_boundary.x = (m_window_height * RatioContant::floorHeightScaleRatio)
                            * RatioContant::attachOffset
                        - m_map_top_offset;
@@ -265,21 +184,17 @@ Map::initSceneTwoMap()
 
             for (size_t k = 0; k < scene_two_floor_tiles[i][j].size(); k++) {
                 if (scene_two_floor_tiles[i][j][k] == 0) {
-                    Floor* glassFloor = new Floor(StringContant::sceneOneFloorName
-                                                      + std::to_string(i + j + k),
-                                                  m_shader,
-                                                  0,
-                                                  heightScale,
-                                                  Floor::FloorTextureType::Grass);
+                    auto grassWidth = static_cast<float>(grassTile->getTextureWidth());
+                    auto grassHeight = heightScale;
 
                     if (i != rowNum - 1) {
-                        glassFloor->scale(glm::vec3(1.0f, RatioContant::attachOffset, 1.0f));
+                        grassHeight = grassHeight * RatioContant::attachOffset;
                     }
 
-                    totalMainFloorXTrans = glassFloor->getTextureGeo().x * j;
-                    glassFloor->translate(glm::vec3(totalMainFloorXTrans, heightScale * i, 0.0f));
-
-                    addChild(glassFloor);
+                    totalMainFloorXTrans = grassWidth * j;
+                    tileMap->addTile(glm::vec2(totalMainFloorXTrans, heightScale * i),
+                                     glm::vec2(grassWidth, grassHeight),
+                                     grassTile);
                 }
                 // Floor obj
                 else if (scene_two_floor_tiles[i][j][k] == 1) {
@@ -341,14 +256,74 @@ Map::initSceneTwoMap()
         }
     }
 
-    // No need to rearrange the drawing order, add first
-    for (auto i : m_floor_obj_layer_one_list) {
-        addChild(i);
-    }
+    tileMap->build();
+    addStaticContent(tileMap, StringContant::sceneTwoStaticLayerName);
 
     m_map_boundary.w = m_map_boundary.w - m_map_right_offset;
 }
 
+void
+Map::initBackgroundLayers(const std::string& name)
+{
+    m_background_layers.clear();
+
+    // Window wide, covering the part of the window above the floor
+    auto height = m_window_height * RatioContant::backgroundHeightScaleRatio;
+    auto bottom = m_window_height * (1.0f - RatioContant::backgroundHeightScaleRatio);
+
+    for (size_t i = 0; i < scene_background_layers.size(); i++) {
+        ParallaxLayer* layer = new ParallaxLayer(name + std::to_string(i),
+                                                 m_shader,
+                                                 m_window_width,
+                                                 height,
+                                                 bottom,
+                                                 scene_background_layers[i]);
+
+        m_background_layers.push_back(layer);
+        addChild(layer);
+    }
+}
+
+void
+Map::addStaticContent(TileMap* tileMap, const std::string& name)
+{
+    // No need to rearrange the drawing order, floor objs go right over the floor
+    std::vector<SceneNode*> staticNodes {tileMap};
+    staticNodes.insert(staticNodes.end(),
+                       m_floor_obj_layer_one_list.begin(),
+                       m_floor_obj_layer_one_list.end());
+
+    if (!StaticLayerCache::enabled) {
+        for (auto i : staticNodes) {
+            addChild(i);
+        }
+
+        return;
+    }
+
+    // Nothing in here changes once built, it is rendered once and drawn from the cache
+    m_static_layer = new StaticLayer(name, m_shader);
+    for (auto i : staticNodes) {
+        m_static_layer->addContent(i);
+    }
+
+    addChild(m_static_layer);
+}
+
+void
+Map::scrollBackground(GLfloat cameraX)
+{
+    for (auto layer : m_background_layers) {
+        layer->scroll(cameraX);
+    }
+}
+
+StaticLayer*
+Map::getStaticLayer()
+{
+    return m_static_layer;
+}
+
 glm::vec4
 Map::getMapBoundary()
 {
@@ -0,0 +1,66 @@
+#include "parallaxlayer.hpp"
+#include "constant.hpp"
+#include "exception.hpp"
+
+#include <gtc/matrix_transform.hpp>
+
+#include <string>
+
+ParallaxLayer::ParallaxLayer(const std::string& name,
+                             ShaderProgram* shader,
+                             GLfloat width,
+                             GLfloat height,
+                             GLfloat bottom,
+                             LayerType layerType)
+    : GeometryNode(name)
+    , m_shader(shader)
+    , m_plane_width(width)
+    , m_plane_height(height)
+    , m_scroll_ratio(1.0f)
+{
+    // Load texture
+    switch (layerType) {
+    case LayerType::Far:
+        m_texture = TextureCache::acquire(TexturePath::backgroundFarPath);
+        m_scroll_ratio = RatioContant::backgroundFarScrollRatio;
+        break;
+    case LayerType::Mid:
+        m_texture = TextureCache::acquire(TexturePath::backgoundMidPath);
+        m_scroll_ratio = RatioContant::backgroundMidScrollRatio;
+        break;
+    default:
+        throw Exception("Unknown parallax layer type: "
+                        + std::to_string(static_cast<int>(layerType)));
+    }
+
+    // S * T * R * T^-1
+    // Scale will have no effect on translation
+    m_base_trans = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, bottom, 0.0f));
+    m_base_trans = glm::scale(m_base_trans, glm::vec3(width, height, 0.0f));
+    m_base_trans = glm::translate(m_base_trans, glm::vec3(0.5f, 0.5f, 0.0f));
+    m_base_trans = glm::rotate(m_base_trans, glm::radians(180.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    m_base_trans = glm::translate(m_base_trans, glm::vec3(-0.5f, -0.5f, 0.0f));
+
+    // Art keeps its pixel width, the quad shows a window wide slice of it
+    m_uv_rect = glm::vec4(0.0f, 0.0f, width / m_texture->getTextureWidth(), 1.0f);
+
+    scroll(0.0f);
+}
+
+void
+ParallaxLayer::scroll(GLfloat cameraX)
+{
+    m_trans = glm::translate(glm::mat4(1.0f), glm::vec3(cameraX, 0.0f, 0.0f)) * m_base_trans;
+
+    GLfloat u0 = cameraX * m_scroll_ratio / m_texture->getTextureWidth();
+    m_uv_rect.z = u0 + (m_uv_rect.z - m_uv_rect.x);
+    m_uv_rect.x = u0;
+}
+
+bool
+ParallaxLayer::submitToBatch(SpriteBatch& spriteBatch)
+{
+    spriteBatch.submit(m_world_trans, m_texture->getTextureId(), m_uv_rect);
+
+    return true;
+}
@@ -0,0 +1,192 @@
+#include "renderqueue.hpp"
+
+#include <algorithm>
+
+// clang-format off
+
+static const int m_level_shift    {48};
+static const int m_program_shift  {40};
+static const int m_texture_shift  {24};
+
+static const uint64_t m_level_mask    {0xFFFF};
+static const uint64_t m_program_mask  {0xFF};
+static const uint64_t m_texture_mask  {0xFFFF};
+static const uint64_t m_sequence_mask {0xFFFFFF};
+
+// Cells per side of the level grid
+static const int m_grid_size          {16};
+
+// clang-format on
+
+static uint64_t
+makeKey(unsigned int level, RenderProgram program, unsigned int texture, size_t sequence)
+{
+    return ((std::min<uint64_t>(level, m_level_mask)) << m_level_shift)
+           | ((static_cast<uint64_t>(program) & m_program_mask) << m_program_shift)
+           | ((static_cast<uint64_t>(texture) & m_texture_mask) << m_texture_shift)
+           | (static_cast<uint64_t>(sequence) & m_sequence_mask);
+}
+
+void
+RenderQueue::clear()
+{
+    m_entries.clear();
+    m_commands.clear();
+}
+
+void
+RenderQueue::push(SceneNode* node, const glm::vec4& bounds, const SceneNode::RenderState& state)
+{
+    m_entries.push_back({node, bounds, state});
+}
+
+void
+RenderQueue::pushShadowPass(const glm::vec4& bounds)
+{
+    // Same program as the characters it goes under
+    m_entries.push_back({nullptr, bounds, {RenderProgram::Character, 0}});
+}
+
+glm::ivec4
+RenderQueue::getGridCells(const glm::vec4& bounds, const glm::vec4& viewRect)
+{
+    glm::vec2 cellSize = glm::max(glm::vec2(viewRect.z - viewRect.x, viewRect.w - viewRect.y)
+                                      / static_cast<float>(m_grid_size),
+                                  glm::vec2(1.0f));
+
+    glm::vec4 origin(viewRect.x, viewRect.y, viewRect.x, viewRect.y);
+
+    // Whatever reaches out of the view falls into the border cells
+    glm::vec4 cells = glm::clamp((bounds - origin) / glm::vec4(cellSize, cellSize),
+                                 glm::vec4(0.0f),
+                                 glm::vec4(static_cast<float>(m_grid_size - 1)));
+
+    return glm::ivec4(cells);
+}
+
+unsigned int
+RenderQueue::assignLevels(const glm::vec4& viewRect)
+{
+    size_t count = m_entries.size();
+
+    m_levels.assign(count, 0);
+    m_grid_entries.resize(m_grid_size * m_grid_size);
+    for (auto& cell : m_grid_entries)
+        cell.clear();
+    m_grid_tops.assign(m_grid_size * m_grid_size, 0);
+
+    unsigned int levels {0};
+    for (size_t i = 0; i < count; i++) {
+        glm::ivec4 cells = getGridCells(m_entries[i].bounds, viewRect);
+
+        // One above the highest earlier entry overlapped, cells with nothing that high
+        // are skipped
+        unsigned int& level = m_levels[i];
+        for (int y = cells.y; y <= cells.w; y++) {
+            for (int x = cells.x; x <= cells.z; x++) {
+                int cell = y * m_grid_size + x;
+                if (m_grid_tops[cell] <= level)
+                    continue;
+
+                for (unsigned int j : m_grid_entries[cell]) {
+                    if (m_levels[j] >= level
+                        && SceneNode::overlaps(m_entries[i].bounds, m_entries[j].bounds))
+                        level = m_levels[j] + 1;
+                }
+            }
+        }
+
+        for (int y = cells.y; y <= cells.w; y++) {
+            for (int x = cells.x; x <= cells.z; x++) {
+                int cell = y * m_grid_size + x;
+                m_grid_entries[cell].push_back(static_cast<unsigned int>(i));
+                m_grid_tops[cell] = std::max(m_grid_tops[cell], level + 1);
+            }
+        }
+
+        levels = std::max(levels, level + 1);
+    }
+
+    return levels;
+}
+
+void
+RenderQueue::sort(const glm::vec4& viewRect)
+{
+    size_t count = m_entries.size();
+
+    // Painter levels, anything overlapped has to be drawn first
+    unsigned int levels = assignLevels(viewRect);
+
+    m_commands.clear();
+    for (size_t i = 0; i < count; i++) {
+        const Entry& entry = m_entries[i];
+
+        m_commands.push_back(
+            {makeKey(m_levels[i], entry.state.program, entry.state.texture, i), entry.node});
+    }
+
+    unsigned int stateChangesUnsorted = countStateChanges(m_commands);
+
+    // LSD radix sort, one byte per pass, skipping bytes every key shares
+    m_scratch.resize(count);
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] {};
+        for (const auto& command : m_commands)
+            histogram[(command.key >> shift) & 0xFF]++;
+
+        if (count == 0 || histogram[(m_commands.front().key >> shift) & 0xFF] == count)
+            continue;
+
+        size_t offset {0};
+        for (auto& bucket : histogram) {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (const auto& command : m_commands)
+            m_scratch[histogram[(command.key >> shift) & 0xFF]++] = command;
+
+        m_commands.swap(m_scratch);
+    }
+
+    m_stats.commands += static_cast<unsigned int>(count);
+    m_stats.levels += levels;
+    m_stats.stateChangesUnsorted += stateChangesUnsorted;
+    m_stats.stateChangesSorted += countStateChanges(m_commands);
+}
+
+unsigned int
+RenderQueue::countStateChanges(const std::vector<Command>& commands)
+{
+    unsigned int changes {0};
+
+    for (size_t i = 1; i < commands.size(); i++) {
+        uint64_t state = commands[i].key >> m_texture_shift;
+        uint64_t previousState = commands[i - 1].key >> m_texture_shift;
+
+        if ((state ^ previousState) & ((m_program_mask << 16) | m_texture_mask))
+            changes++;
+    }
+
+    return changes;
+}
+
+const std::vector<RenderQueue::Command>&
+RenderQueue::getCommands() const
+{
+    return m_commands;
+}
+
+void
+RenderQueue::resetStats()
+{
+    m_stats = Stats();
+}
+
+const RenderQueue::Stats&
+RenderQueue::getStats() const
+{
+    return m_stats;
+}
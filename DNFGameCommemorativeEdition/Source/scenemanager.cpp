@@ -2,6 +2,7 @@
 
 #include "game.hpp"
 #include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
 #include "monster.hpp"
 
 #include <gtc/matrix_transform.hpp>
@@ -9,16 +10,19 @@
 #include <gtx/io.hpp>
 #include <gtx/string_cast.hpp>
 
+#include <limits>
+
 // Update mesh specific shader uniforms:
 static void
-updateShaderUniforms(const ShaderProgram* shader, const glm::mat4& nodeTrans)
+updateShaderUniforms(ShaderProgram* shader,
+                     ShaderProgram::UniformId modelUniId,
+                     const glm::mat4& nodeTrans)
 {
     // No need to enable shader since within draw of Game
     {
         //-- Set ModelView matrix:
-        auto M_uni = shader->getUniformLocation("M");
-
-        glUniformMatrix4fv(M_uni, 1, GL_FALSE, value_ptr(nodeTrans));
+        // Skipped when the node shares the transform of the previous one
+        shader->set(modelUniId, nodeTrans);
         CHECK_GL_ERRORS;
     }
 }
@@ -26,19 +30,42 @@ updateShaderUniforms(const ShaderProgram* shader, const glm::mat4& nodeTrans)
 SceneManager::SceneManager(ShaderProgram* shader,
                            GLfloat frameBufferWidth,
                            GLfloat frameBufferHeight,
-                           GLFWwindow* window)
+                           GLFWwindow* window,
+                           CameraUniformBuffer* cameraUbo)
     : m_shader(shader)
+    , m_view_rect(glm::vec4(0.0f, 0.0f, frameBufferWidth, frameBufferHeight))
+    , m_shadow_bounds(glm::vec4(0.0f))
+    , m_shadow_pass_queued(false)
     , m_frame_buffer_width(frameBufferWidth)
     , m_frame_buffer_height(frameBufferHeight)
+    , m_current_scene_state(CurrentSceneState::SceneZeroPrep)
     , m_player(std::make_unique<Player>(m_shader))
     , m_npc(std::make_unique<NPC>(m_shader))
     , m_dialog_scene_node(
           std::make_unique<DialogSceneNode>(m_shader, frameBufferWidth, frameBufferHeight))
     , m_star_particles_generator(std::make_unique<StarParticlesGenerator>(m_shader))
-    , m_current_scene_state(CurrentSceneState::SceneZeroPrep)
+    , m_scene_zero_bg_sound(nullptr)
+    , m_button_hover_sound(nullptr)
+    , m_button_click_sound(nullptr)
+    , m_scenes_bg_sound(nullptr)
+    , m_scene_zero_bg(nullptr)
+    , m_button_hover(nullptr)
+    , m_button_click(nullptr)
+    , m_scenes_bg(nullptr)
     , m_window(window)
+    , m_camera_ubo(cameraUbo)
 {
+    m_model_uni_id = m_shader->getUniformId("M");
+
+    m_sprite_batch = std::make_unique<SpriteBatch>(m_shader);
+    m_character_batch = std::make_unique<CharacterBatch>();
+    m_shadow_pass = std::make_unique<ShadowPass>();
+    m_render_queue = std::make_unique<RenderQueue>();
+
     // Init Sounds
+    if (Game::getSoundEngine() == nullptr)
+        return;
+
     m_scene_zero_bg = Game::getSoundEngine()->addSoundSourceFromFile(SoundPath::sceneZeroBg.c_str());
     m_button_hover = Game::getSoundEngine()->addSoundSourceFromFile(SoundPath::buttonHover.c_str());
     m_button_click = Game::getSoundEngine()->addSoundSourceFromFile(SoundPath::buttonClick.c_str());
@@ -69,14 +96,27 @@ SceneManager::constructScenes()
                                              m_star_particles_generator.get());
 }
 
+void
+SceneManager::setViewRect(const glm::vec4& viewRect)
+{
+    m_view_rect = viewRect;
+}
+
 void
 SceneManager::drawCurrentScene()
 {
+    m_traversal_stats = TraversalStats();
+    m_sprite_batch->resetStats();
+    m_character_batch->resetStats();
+    m_shadow_pass->resetStats();
+    m_render_queue->resetStats();
+
     switch (m_current_scene_state) {
     case CurrentSceneState::SceneZeroPrep:
         m_scene_zero->prepareInitialDisplay();
 
-        if (!Game::getSoundEngine()->isCurrentlyPlaying(m_scene_zero_bg))
+        if (Game::getSoundEngine() != nullptr
+            && !Game::getSoundEngine()->isCurrentlyPlaying(m_scene_zero_bg))
             m_scene_zero_bg_sound = Game::getSoundEngine()->play2D(m_scene_zero_bg,
                                                                    true,
                                                                    false,
@@ -89,11 +129,15 @@ SceneManager::drawCurrentScene()
         break;
     case CurrentSceneState::SceneOnePrep:
         m_scene_one->prepareInitialDisplay();
-        m_scene_zero_bg_sound->stop();
-        m_scene_zero_bg_sound->drop();
+        if (m_scene_zero_bg_sound != nullptr) {
+            m_scene_zero_bg_sound->stop();
+            m_scene_zero_bg_sound->drop();
+            m_scene_zero_bg_sound = nullptr;
+        }
 
         // Scene zero bgm
-        if (!Game::getSoundEngine()->isCurrentlyPlaying(m_scenes_bg))
+        if (Game::getSoundEngine() != nullptr
+            && !Game::getSoundEngine()->isCurrentlyPlaying(m_scenes_bg))
             m_scenes_bg_sound = Game::getSoundEngine()->play2D(m_scenes_bg, true, false, true);
 
         m_current_scene_state = CurrentSceneState::SceneOneReady;
@@ -117,15 +161,15 @@ SceneManager::drawCurrentScene()
 void
 SceneManager::drawSceneOne()
 {
-    renderSceneGraphNodes(m_scene_one->getRootSceneNode(),
-                          m_scene_one->getRootSceneNode()->getTransform());
+    updateStaticLayer(m_scene_one->getStaticLayer());
+    renderSceneGraph(m_scene_one->getRootSceneNode());
 }
 
 void
 SceneManager::drawSceneTwo()
 {
-    renderSceneGraphNodes(m_scene_two->getRootSceneNode(),
-                          m_scene_two->getRootSceneNode()->getTransform());
+    updateStaticLayer(m_scene_two->getStaticLayer());
+    renderSceneGraph(m_scene_two->getRootSceneNode());
 
     m_scene_two->checkToRemoveMonster();
     m_scene_two->updateMonsterFlockingMovements();
@@ -134,12 +178,138 @@ SceneManager::drawSceneTwo()
 void
 SceneManager::drawSceneZero()
 {
-    renderSceneGraphNodes(m_scene_zero->getRootSceneNode(),
-                          m_scene_zero->getRootSceneNode()->getTransform());
+    renderSceneGraph(m_scene_zero->getRootSceneNode());
+}
+
+const SceneManager::TraversalStats&
+SceneManager::getTraversalStats() const
+{
+    return m_traversal_stats;
+}
+
+void
+SceneManager::printTraversalStats() const
+{
+    std::cout << "Scene traversal (last frame) visited nodes: " << m_traversal_stats.visitedNodes
+              << ", model matrix pushes: " << m_traversal_stats.modelMatPushes
+              << ", visible nodes: " << m_traversal_stats.visibleNodes
+              << ", culled nodes: " << m_traversal_stats.culledNodes << std::endl;
+    std::cout << "SpriteBatch (last frame) quads: " << m_sprite_batch->getStats().quads
+              << ", draw calls: " << m_sprite_batch->getStats().drawCalls << std::endl;
+    std::cout << "CharacterBatch (last frame) instances: "
+              << m_character_batch->getStats().instances
+              << ", draw calls: " << m_character_batch->getStats().drawCalls << std::endl;
+    std::cout << "ShadowPass (last frame) instances: " << m_shadow_pass->getStats().instances
+              << ", draw calls: " << m_shadow_pass->getStats().drawCalls << std::endl;
+    std::cout << "RenderQueue (last frame) commands: " << m_render_queue->getStats().commands
+              << ", painter levels: " << m_render_queue->getStats().levels
+              << ", state changes unsorted: " << m_render_queue->getStats().stateChangesUnsorted
+              << ", sorted: " << m_render_queue->getStats().stateChangesSorted << std::endl;
 }
 
 void
-SceneManager::renderSceneGraphNodes(SceneNode* node, glm::mat4 modelMat)
+SceneManager::renderSceneGraph(SceneNode* root)
+{
+    if (root == nullptr)
+        return;
+
+    m_shadow_bounds = glm::vec4(std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::lowest(),
+                                std::numeric_limits<float>::lowest());
+    m_shadow_pass_queued = false;
+
+    updateWorldTransforms(root, root->getTransform());
+
+    m_render_queue->clear();
+    queueSceneGraphNodes(root);
+    m_render_queue->sort(m_view_rect);
+
+    runRenderQueue();
+}
+
+/*
+ * Render the static layer content into its tiles, only when it is dirty.
+ * Runs before the scene is drawn, everything it changes (framebuffer, viewport, camera,
+ * view rect) is put back after.
+ */
+void
+SceneManager::updateStaticLayer(StaticLayer* staticLayer)
+{
+    if (staticLayer == nullptr || !staticLayer->isDirty())
+        return;
+
+    SceneNode* contentRoot = staticLayer->getContentRoot();
+    glm::vec4 viewRect = m_view_rect;
+
+    // Measure the content with nothing culled
+    m_view_rect = glm::vec4(std::numeric_limits<float>::lowest(),
+                            std::numeric_limits<float>::lowest(),
+                            std::numeric_limits<float>::max(),
+                            std::numeric_limits<float>::max());
+    updateWorldTransforms(contentRoot, contentRoot->getTransform());
+
+    glm::vec4 bounds {std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest()};
+    accumulateWorldBounds(contentRoot, bounds);
+
+    // Tiles as wide as the window, a frame never touches more than two of them
+    staticLayer->resize(bounds, m_frame_buffer_width);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glm::mat4 proj = m_camera_ubo->getProj();
+    glm::mat4 view = m_camera_ubo->getView();
+
+    GLStateCache::setPremultipliedTarget(true);
+
+    for (unsigned int i = 0; i < staticLayer->getTilesCount(); i++) {
+        glm::vec4 tileRect = staticLayer->bindTile(i);
+
+        m_camera_ubo->update(
+            glm::ortho(tileRect.x, tileRect.z, tileRect.y, tileRect.w, -1.0f, 1.0f),
+            glm::mat4(1.0f));
+        m_view_rect = tileRect;
+
+        renderSceneGraph(contentRoot);
+    }
+
+    GLStateCache::setPremultipliedTarget(false);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    m_camera_ubo->update(proj, view);
+    m_view_rect = viewRect;
+
+    staticLayer->validate();
+
+    CHECK_GL_ERRORS;
+}
+
+void
+SceneManager::accumulateWorldBounds(SceneNode* node, glm::vec4& bounds)
+{
+    if (node == nullptr)
+        return;
+
+    if (node->m_node_type == NodeType::GeometryNode && !node->m_culled) {
+        glm::vec4 nodeBounds = node->getWorldBounds();
+
+        bounds = glm::vec4(glm::min(bounds.x, nodeBounds.x),
+                           glm::min(bounds.y, nodeBounds.y),
+                           glm::max(bounds.z, nodeBounds.z),
+                           glm::max(bounds.w, nodeBounds.w));
+    }
+
+    for (auto i : node->m_children) {
+        accumulateWorldBounds(i, bounds);
+    }
+}
+
+void
+SceneManager::updateWorldTransforms(SceneNode* node, const glm::mat4& modelMat)
 {
     if (node == nullptr)
         return;
@@ -147,23 +317,106 @@ SceneManager::renderSceneGraphNodes(SceneNode* node, glm::mat4 modelMat)
     glm::mat4 trans {1.0f};
     if (node->m_node_type == NodeType::GeometryNode) {
         trans = modelMat * node->getTransform();
-        updateShaderUniforms(m_shader, trans);
-        m_player->updateShadowShaderModelMat(trans);
-        m_npc->updateShadowShaderModelMat(trans);
-        m_star_particles_generator->updateParticleShaderModelMat(trans);
-        if (m_current_scene_state == CurrentSceneState::SceneTwoReady) {
-            for (auto& i : m_scene_two->getMonsters()) {
-                i->updateShadowShaderModelMat(trans);
+        node->m_world_trans = trans;
+
+        // Culled characters also skip their animation, it advances with the shadow.
+        // Game logic must not wait on it, see Monster::updateKilled().
+        node->m_culled = !node->isVisible(m_view_rect);
+        if (node->m_culled) {
+            m_traversal_stats.culledNodes++;
+        } else {
+            m_traversal_stats.visibleNodes++;
+            node->submitShadow(*m_shadow_pass);
+
+            // The shadow pass is queued as one command covering every character
+            if (node->getRenderState().program == RenderProgram::Character) {
+                glm::vec4 bounds = node->getWorldBounds();
+
+                m_shadow_bounds = glm::vec4(glm::min(m_shadow_bounds.x, bounds.x),
+                                            glm::min(m_shadow_bounds.y, bounds.y),
+                                            glm::max(m_shadow_bounds.z, bounds.z),
+                                            glm::max(m_shadow_bounds.w, bounds.w));
             }
         }
+    }
+
+    for (auto i : node->m_children) {
+        updateWorldTransforms(i, trans);
+    }
+}
+
+void
+SceneManager::queueSceneGraphNodes(SceneNode* node)
+{
+    if (node == nullptr)
+        return;
+
+    m_traversal_stats.visitedNodes++;
+
+    if (node->m_node_type == NodeType::GeometryNode && !node->m_culled) {
+        SceneNode::RenderState state = node->getRenderState();
+
+        // All the shadows go down right under the first character
+        if (state.program == RenderProgram::Character && !m_shadow_pass_queued) {
+            m_render_queue->pushShadowPass(m_shadow_bounds);
+            m_shadow_pass_queued = true;
+        }
 
-        node->draw();
+        m_render_queue->push(node, node->getWorldBounds(), state);
     }
 
     // All the children except the last
     for (auto i : node->m_children) {
-        renderSceneGraphNodes(i, trans);
+        queueSceneGraphNodes(i);
+    }
+}
+
+void
+SceneManager::runRenderQueue()
+{
+    for (const auto& command : m_render_queue->getCommands()) {
+        SceneNode* node = command.node;
+
+        if (node == nullptr) {
+            flushCharacterBatch();
+            m_sprite_batch->flush();
+
+            if (m_shadow_pass->run())
+                m_shader->enable();
+
+            continue;
+        }
+
+        // Static sprites and characters are queued, anything else breaks the current runs.
+        // Only one of the batches holds pending work at a time, which keeps the sorted
+        // order: queuing into one flushes the other.
+        if (node->submitToBatch(*m_sprite_batch)) {
+            flushCharacterBatch();
+        } else if (node->submitToCharacterBatch(*m_character_batch)) {
+            m_sprite_batch->flush();
+        } else {
+            flushCharacterBatch();
+            m_sprite_batch->flush();
+
+            updateShaderUniforms(m_shader, m_model_uni_id, node->m_world_trans);
+            m_traversal_stats.modelMatPushes++;
+
+            node->draw();
+        }
     }
+
+    flushCharacterBatch();
+    m_sprite_batch->flush();
+}
+
+void
+SceneManager::flushCharacterBatch()
+{
+    if (m_character_batch->isEmpty())
+        return;
+
+    m_character_batch->flush();
+    m_shader->enable();
 }
 
 void
@@ -243,7 +496,7 @@ SceneManager::processMouseMove(const glm::vec2& mousePos)
 {
     switch (m_current_scene_state) {
     case CurrentSceneState::SceneZeroReady:
-        if (m_scene_zero->processHover(mousePos)) {
+        if (m_scene_zero->processHover(mousePos) && Game::getSoundEngine() != nullptr) {
             // Button hover sound
             if (Game::getSoundEngine()->isCurrentlyPlaying(m_button_hover)) {
                 m_button_hover_sound->stop();
@@ -263,7 +516,7 @@ SceneManager::processMouseMove(const glm::vec2& mousePos)
         m_scene_one->processHover(mousePos);
         break;
     case CurrentSceneState::SceneTwoReady:
-        if (m_scene_two->processHover(mousePos)) {
+        if (m_scene_two->processHover(mousePos) && Game::getSoundEngine() != nullptr) {
             // Button hover sound
             if (Game::getSoundEngine()->isCurrentlyPlaying(m_button_hover)) {
                 m_button_hover_sound->stop();
@@ -296,7 +549,7 @@ SceneManager::processLeftMouseClick()
         }
         break;
     case CurrentSceneState::SceneOneReady:
-        if (m_scene_one->processClick()) {
+        if (m_scene_one->processClick() && Game::getSoundEngine() != nullptr) {
             // Dialog click sound
             if (Game::getSoundEngine()->isCurrentlyPlaying(m_button_click)) {
                 m_button_click_sound->stop();
@@ -314,7 +567,7 @@ SceneManager::processLeftMouseClick()
         break;
     case CurrentSceneState::SceneTwoReady: {
         auto currentEvent = m_scene_two->processClick();
-        if (currentEvent == Scene::SceneEvents::DialogClick) {
+        if (currentEvent == Scene::SceneEvents::DialogClick && Game::getSoundEngine() != nullptr) {
             // Dialog click sound
             if (Game::getSoundEngine()->isCurrentlyPlaying(m_button_click)) {
                 m_button_click_sound->stop();
@@ -331,7 +584,8 @@ SceneManager::processLeftMouseClick()
         } else if (currentEvent == Scene::SceneEvents::QuitGame) {
             glfwSetWindowShouldClose(m_window, GL_TRUE);
         } else if (currentEvent == Scene::SceneEvents::SceneTransit) {
-            m_scenes_bg_sound->stop();
+            if (m_scenes_bg_sound != nullptr)
+                m_scenes_bg_sound->stop();
             m_player->cleanMovement();
             m_dialog_scene_node->clearMovement();
 
@@ -360,6 +614,22 @@ SceneManager::moveDialog(float dx)
     }
 }
 
+void
+SceneManager::scrollBackground(float cameraX)
+{
+    // Parallax layers follow the camera
+    switch (m_current_scene_state) {
+    case CurrentSceneState::SceneOneReady:
+        m_scene_one->scrollBackground(cameraX);
+        break;
+    case CurrentSceneState::SceneTwoReady:
+        m_scene_two->scrollBackground(cameraX);
+        break;
+    default:
+        break;
+    }
+}
+
 Player*
 SceneManager::getPlayer()
 {
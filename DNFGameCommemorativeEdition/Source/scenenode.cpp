@@ -1,6 +1,8 @@
 #include "scenenode.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include <glm.hpp>
@@ -10,6 +12,8 @@ SceneNode::SceneNode(const std::string& name)
     : m_name(name)
     , m_node_type(NodeType::SceneNode)
     , m_trans(glm::mat4(1.0f))
+    , m_world_trans(glm::mat4(1.0f))
+    , m_culled(false)
 {}
 
 // Deep copy
@@ -18,6 +22,8 @@ SceneNode::SceneNode(const SceneNode& other)
     , m_name(other.m_name)
     , m_trans(other.m_trans)
     , m_invtrans(other.m_invtrans)
+    , m_world_trans(other.m_world_trans)
+    , m_culled(other.m_culled)
 {
     for (SceneNode* child : other.m_children) {
         this->m_children.push_front(new SceneNode(*child));
@@ -50,6 +56,47 @@ SceneNode::getInverse()
     return m_invtrans;
 }
 
+bool
+SceneNode::isVisible(const glm::vec4& viewRect)
+{
+    return overlaps(getWorldBounds(), viewRect);
+}
+
+glm::vec4
+SceneNode::getWorldBounds()
+{
+    // Sprites are unit quads scaled by their transform
+    return getQuadBounds(m_world_trans);
+}
+
+glm::vec4
+SceneNode::getQuadBounds(const glm::mat4& trans)
+{
+    glm::vec4 bounds {std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest()};
+
+    for (float x = 0.0f; x <= 1.0f; x += 1.0f) {
+        for (float y = 0.0f; y <= 1.0f; y += 1.0f) {
+            glm::vec4 corner = trans * glm::vec4(x, y, 0.0f, 1.0f);
+
+            bounds.x = std::min(bounds.x, corner.x);
+            bounds.y = std::min(bounds.y, corner.y);
+            bounds.z = std::max(bounds.z, corner.x);
+            bounds.w = std::max(bounds.w, corner.y);
+        }
+    }
+
+    return bounds;
+}
+
+bool
+SceneNode::overlaps(const glm::vec4& a, const glm::vec4& b)
+{
+    return a.x <= b.z && b.x <= a.z && a.y <= b.w && b.y <= a.w;
+}
+
 void
 SceneNode::addChild(SceneNode* child)
 {
@@ -135,6 +135,18 @@ SceneOne::moveDialog(float dx)
     m_dialog_scene_node->moveDialog(glm::vec3(dx, 0.0f, 0.0f));
 }
 
+void
+SceneOne::scrollBackground(float cameraX)
+{
+    m_scene_one_map->scrollBackground(cameraX);
+}
+
+StaticLayer*
+SceneOne::getStaticLayer()
+{
+    return m_scene_one_map->getStaticLayer();
+}
+
 bool
 SceneOne::processHover(const glm::vec2& mousePos)
 {
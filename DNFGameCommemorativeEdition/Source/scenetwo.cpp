@@ -156,6 +156,11 @@ SceneTwo::prepareInitialDisplay()
 void
 SceneTwo::checkToRemoveMonster()
 {
+    // Out of the draw path, a monster killed out of view still finishes
+    for (auto monster : m_monsters) {
+        monster->updateKilled();
+    }
+
     // Erase will also destory the obj within
     m_monsters.erase(std::remove_if(m_monsters.begin(),
                                     m_monsters.end(),
@@ -333,6 +338,18 @@ SceneTwo::moveDialog(float dx)
     m_dialog_scene_node->moveDialog(glm::vec3(dx, 0.0f, 0.0f));
 }
 
+void
+SceneTwo::scrollBackground(float cameraX)
+{
+    m_scene_two_map->scrollBackground(cameraX);
+}
+
+StaticLayer*
+SceneTwo::getStaticLayer()
+{
+    return m_scene_two_map->getStaticLayer();
+}
+
 bool
 SceneTwo::processHover(const glm::vec2& mousePos)
 {
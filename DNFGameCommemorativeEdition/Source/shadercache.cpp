@@ -0,0 +1,47 @@
+#include "shadercache.hpp"
+#include "camerauniformbuffer.hpp"
+
+#include <unordered_map>
+
+static unsigned int m_compiled_programs_count {0};
+
+// Heap allocated on purpose, handles can still be released during static destruction.
+static std::unordered_map<std::string, std::weak_ptr<ShaderProgram>>&
+getCacheEntries()
+{
+    static auto* entries = new std::unordered_map<std::string, std::weak_ptr<ShaderProgram>>();
+
+    return *entries;
+}
+
+std::shared_ptr<ShaderProgram>
+ShaderCache::acquire(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+{
+    auto& entries = getCacheEntries();
+    std::string key {vertexShaderPath + "|" + fragmentShaderPath};
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        if (auto program = it->second.lock())
+            return program;
+    }
+
+    auto program = std::make_shared<ShaderProgram>();
+    program->generateProgramObject();
+    program->attachVertexShader(vertexShaderPath.c_str());
+    program->attachFragmentShader(fragmentShaderPath.c_str());
+    program->link();
+    CameraUniformBuffer::bindProgram(*program);
+
+    m_compiled_programs_count++;
+
+    entries[key] = program;
+
+    return program;
+}
+
+unsigned int
+ShaderCache::getCompiledProgramsCount()
+{
+    return m_compiled_programs_count;
+}
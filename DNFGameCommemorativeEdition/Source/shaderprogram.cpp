@@ -1,9 +1,12 @@
 #include "shaderprogram.hpp"
 #include "shaderexception.hpp"
 #include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
 
 #include <glm.hpp>
+#include <gtc/type_ptr.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -134,6 +137,8 @@ ShaderProgram::link()
     glLinkProgram(programObject);
     checkLinkStatus();
 
+    cacheActiveUniformsAndAttribs();
+
     CHECK_GL_ERRORS;
 }
 
@@ -149,6 +154,7 @@ ShaderProgram::deleteShaders()
 {
     glDeleteShader(vertexShader.shaderObject);
     glDeleteShader(fragmentShader.shaderObject);
+    GLStateCache::onProgramDeleted(programObject);
     glDeleteProgram(programObject);
 }
 
@@ -204,7 +210,7 @@ ShaderProgram::checkCompilationStatus(GLuint shaderObject)
 void
 ShaderProgram::enable() const
 {
-    glUseProgram(programObject);
+    GLStateCache::useProgram(programObject);
     CHECK_GL_ERRORS;
 }
 
@@ -212,7 +218,7 @@ ShaderProgram::enable() const
 void
 ShaderProgram::disable() const
 {
-    glUseProgram((GLuint) NULL);
+    GLStateCache::useProgram((GLuint) NULL);
     CHECK_GL_ERRORS;
 }
 
@@ -251,6 +257,78 @@ ShaderProgram::getProgramObject() const
     return programObject;
 }
 
+//------------------------------------------------------------------------------------
+/*
+ * Resolves every active uniform and attribute once, so the per frame lookups become a
+ * table access instead of a glGet*Location string search.
+ */
+void
+ShaderProgram::cacheActiveUniformsAndAttribs()
+{
+    uniforms.clear();
+    uniformIds.clear();
+    attribLocations.clear();
+
+    GLint activeCount {0};
+    GLint maxNameLength {0};
+
+    glGetProgramiv(programObject, GL_ACTIVE_UNIFORMS, &activeCount);
+    glGetProgramiv(programObject, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    vector<GLchar> nameBuffer(maxNameLength + 1);
+    for (GLint i = 0; i < activeCount; i++) {
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(programObject,
+                           i,
+                           static_cast<GLsizei>(nameBuffer.size()),
+                           nullptr,
+                           &size,
+                           &type,
+                           nameBuffer.data());
+
+        // Arrays are reported as "name[0]"
+        string name(nameBuffer.data());
+        auto bracket = name.find('[');
+        if (bracket != string::npos)
+            name = name.substr(0, bracket);
+
+        // Uniform block members have no location
+        GLint location = glGetUniformLocation(programObject, name.c_str());
+        if (location == -1)
+            continue;
+
+        Uniform uniform;
+        uniform.location = location;
+        uniform.type = type;
+        uniform.hasValue = false;
+
+        uniformIds[name] = static_cast<UniformId>(uniforms.size());
+        uniforms.push_back(uniform);
+    }
+
+    glGetProgramiv(programObject, GL_ACTIVE_ATTRIBUTES, &activeCount);
+    glGetProgramiv(programObject, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxNameLength);
+
+    nameBuffer.resize(maxNameLength + 1);
+    for (GLint i = 0; i < activeCount; i++) {
+        GLint size;
+        GLenum type;
+        glGetActiveAttrib(programObject,
+                          i,
+                          static_cast<GLsizei>(nameBuffer.size()),
+                          nullptr,
+                          &size,
+                          &type,
+                          nameBuffer.data());
+
+        attribLocations[nameBuffer.data()] = glGetAttribLocation(programObject,
+                                                                 nameBuffer.data());
+    }
+
+    CHECK_GL_ERRORS;
+}
+
 //------------------------------------------------------------------------------------
 /*
  * Returns the location value of a uniform variable within the shader program.
@@ -258,6 +336,11 @@ ShaderProgram::getProgramObject() const
 GLint
 ShaderProgram::getUniformLocation(const char* uniformName) const
 {
+    auto it = uniformIds.find(uniformName);
+    if (it != uniformIds.end())
+        return uniforms[it->second].location;
+
+    // Not in the table, e.g. a specific array element
     GLint result = glGetUniformLocation(programObject, (const GLchar*) uniformName);
 
     if (result == -1) {
@@ -276,6 +359,10 @@ ShaderProgram::getUniformLocation(const char* uniformName) const
 GLint
 ShaderProgram::getAttribLocation(const char* attributeName) const
 {
+    auto it = attribLocations.find(attributeName);
+    if (it != attribLocations.end())
+        return it->second;
+
     GLint result = glGetAttribLocation(programObject, (const GLchar*) attributeName);
 
     if (result == -1) {
@@ -286,3 +373,104 @@ ShaderProgram::getAttribLocation(const char* attributeName) const
 
     return result;
 }
+
+//------------------------------------------------------------------------------------
+/*
+ * Returns the id of an active uniform, to be used with set().
+ */
+ShaderProgram::UniformId
+ShaderProgram::getUniformId(const char* uniformName) const
+{
+    auto it = uniformIds.find(uniformName);
+
+    if (it == uniformIds.end()) {
+        stringstream errorMessage;
+        errorMessage << "Error obtaining uniform id: " << uniformName;
+        throw ShaderException(errorMessage.str());
+    }
+
+    return it->second;
+}
+
+//------------------------------------------------------------------------------------
+/*
+ * Points a named uniform block at a buffer binding point.
+ */
+bool
+ShaderProgram::bindUniformBlock(const char* blockName, GLuint bindingPoint)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(programObject, (const GLchar*) blockName);
+
+    if (blockIndex == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(programObject, blockIndex, bindingPoint);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+/*
+ * Returns true if the value differs from the shadow copy, which is then updated.
+ */
+bool
+ShaderProgram::updateShadowCopy(UniformId id, const void* data, size_t size)
+{
+    Uniform& uniform = uniforms[id];
+
+    if (uniform.hasValue && memcmp(uniform.value, data, size) == 0)
+        return false;
+
+    memcpy(uniform.value, data, size);
+    uniform.hasValue = true;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, GLint value)
+{
+    if (updateShadowCopy(id, &value, sizeof(value)))
+        glUniform1i(uniforms[id].location, value);
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, GLfloat value)
+{
+    if (updateShadowCopy(id, &value, sizeof(value)))
+        glUniform1f(uniforms[id].location, value);
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, const glm::vec2& value)
+{
+    if (updateShadowCopy(id, glm::value_ptr(value), sizeof(value)))
+        glUniform2fv(uniforms[id].location, 1, glm::value_ptr(value));
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, const glm::vec3& value)
+{
+    if (updateShadowCopy(id, glm::value_ptr(value), sizeof(value)))
+        glUniform3fv(uniforms[id].location, 1, glm::value_ptr(value));
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, const glm::vec4& value)
+{
+    if (updateShadowCopy(id, glm::value_ptr(value), sizeof(value)))
+        glUniform4fv(uniforms[id].location, 1, glm::value_ptr(value));
+}
+
+//------------------------------------------------------------------------------------
+void
+ShaderProgram::set(UniformId id, const glm::mat4& value)
+{
+    if (updateShadowCopy(id, glm::value_ptr(value), sizeof(value)))
+        glUniformMatrix4fv(uniforms[id].location, 1, GL_FALSE, glm::value_ptr(value));
+}
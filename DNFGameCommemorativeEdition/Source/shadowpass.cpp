@@ -0,0 +1,218 @@
+#include "shadowpass.hpp"
+#include "shadercache.hpp"
+#include "constant.hpp"
+
+#include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+#include "streambuffer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// clang-format off
+
+// mat4 + vec4 + vec2
+static const int m_floats_per_instance {22};
+
+// clang-format on
+
+const glm::vec2 ShadowPass::defaultShear {0.4f, 0.3f};
+
+ShadowPass::ShadowPass()
+{
+    // Shadow shader is shared by all characters
+    m_shadow_shader = ShaderCache::acquire(ShadowShaderPath::vertexShader,
+                                           ShadowShaderPath::fragmentShader);
+
+    m_model_attrib_pos = m_shadow_shader->getAttribLocation("model");
+    m_uv_rect_attrib_pos = m_shadow_shader->getAttribLocation("uvRect");
+    m_shear_attrib_pos = m_shadow_shader->getAttribLocation("shear");
+
+    // Create the vertex array to record buffer assignments for the pass.
+    glGenVertexArrays(1, &m_shadow_pass_vao);
+    glBindVertexArray(m_shadow_pass_vao);
+
+    // No per vertex buffer, the shader builds the unit quad from gl_VertexID.
+    // Instances are streamed on run, the pointers are set per draw.
+    // mat4 takes four consecutive attribute locations
+    for (GLuint i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(m_model_attrib_pos + i);
+        glVertexAttribDivisor(m_model_attrib_pos + i, 1);
+    }
+
+    glEnableVertexAttribArray(m_uv_rect_attrib_pos);
+    glVertexAttribDivisor(m_uv_rect_attrib_pos, 1);
+
+    glEnableVertexAttribArray(m_shear_attrib_pos);
+    glVertexAttribDivisor(m_shear_attrib_pos, 1);
+
+    // Reset state to prevent rogue code from messing with *my* stuff!
+    glBindVertexArray(0);
+
+    CHECK_GL_ERRORS;
+}
+
+ShadowPass::~ShadowPass()
+{
+    glDeleteVertexArrays(1, &m_shadow_pass_vao);
+}
+
+void
+ShadowPass::setInstanceAttribPointers(GLintptr base)
+{
+    // GL 3.3 has no base instance, offset the instance attributes instead
+    GLsizei stride = sizeof(GLfloat) * m_floats_per_instance;
+
+    for (GLuint i = 0; i < 4; i++) {
+        glVertexAttribPointer(m_model_attrib_pos + i,
+                              4,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              stride,
+                              (void*) (base + sizeof(GLfloat) * 4 * i));
+    }
+
+    glVertexAttribPointer(m_uv_rect_attrib_pos,
+                          4,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*) (base + sizeof(GLfloat) * 16));
+
+    glVertexAttribPointer(m_shear_attrib_pos,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*) (base + sizeof(GLfloat) * 20));
+}
+
+void
+ShadowPass::submit(const glm::mat4& modelMat,
+                   GLuint textureId,
+                   const glm::vec4& uvRect,
+                   const glm::vec2& shear)
+{
+    m_instances.push_back({modelMat, uvRect, shear, textureId});
+}
+
+glm::vec4
+ShadowPass::getCasterBounds(const glm::mat4& spriteTrans,
+                            const glm::mat4& shadowModelMat,
+                            const glm::vec2& shear)
+{
+    glm::vec4 bounds {std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest()};
+
+    for (float x = 0.0f; x <= 1.0f; x += 1.0f) {
+        for (float y = 0.0f; y <= 1.0f; y += 1.0f) {
+            // Same shear as shadow_shader.vert
+            glm::vec4 corners[2] = {spriteTrans * glm::vec4(x, y, 0.0f, 1.0f),
+                                    shadowModelMat
+                                        * glm::vec4(x + shear.x * y, shear.y * y, 0.0f, 1.0f)};
+
+            for (const auto& corner : corners) {
+                bounds.x = std::min(bounds.x, corner.x);
+                bounds.y = std::min(bounds.y, corner.y);
+                bounds.z = std::max(bounds.z, corner.x);
+                bounds.w = std::max(bounds.w, corner.y);
+            }
+        }
+    }
+
+    return bounds;
+}
+
+bool
+ShadowPass::run()
+{
+    if (m_instances.empty())
+        return false;
+
+    // Group by sprite sheet, one draw per sheet
+    std::stable_sort(m_instances.begin(),
+                     m_instances.end(),
+                     [](const Instance& a, const Instance& b) {
+                         return a.textureId < b.textureId;
+                     });
+
+    m_instance_data.clear();
+    for (const auto& instance : m_instances) {
+        const GLfloat* modelMat = &instance.modelMat[0][0];
+        m_instance_data.insert(m_instance_data.end(), modelMat, modelMat + 16);
+        m_instance_data.push_back(instance.uvRect.x);
+        m_instance_data.push_back(instance.uvRect.y);
+        m_instance_data.push_back(instance.uvRect.z);
+        m_instance_data.push_back(instance.uvRect.w);
+        m_instance_data.push_back(instance.shear.x);
+        m_instance_data.push_back(instance.shear.y);
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instance_data.size() * sizeof(GLfloat));
+    GLintptr offset = StreamBuffer::upload(m_instance_data.data(), size);
+
+    if (offset < 0) {
+        m_instances.clear();
+
+        return false;
+    }
+
+    m_shadow_shader->enable();
+
+    // Draw transparent backgrounds in blend mode (alpha channel)
+    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
+    GLStateCache::depthMask(GL_FALSE);
+
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(m_shadow_pass_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, StreamBuffer::getBufferId());
+
+    size_t runStart = 0;
+    while (runStart < m_instances.size()) {
+        size_t runEnd = runStart + 1;
+        while (runEnd < m_instances.size()
+               && m_instances[runEnd].textureId == m_instances[runStart].textureId)
+            runEnd++;
+
+        // Texture unit 0, sampler2D in shader
+        GLStateCache::bindTexture2D(m_instances[runStart].textureId);
+
+        setInstanceAttribPointers(offset + runStart * sizeof(GLfloat) * m_floats_per_instance);
+        glDrawArraysInstanced(GL_TRIANGLES,
+                              0,
+                              UnitQuad::verticesCount,
+                              static_cast<GLsizei>(runEnd - runStart));
+
+        m_stats.drawCalls++;
+        runStart = runEnd;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
+
+    m_stats.instances += static_cast<unsigned int>(m_instances.size());
+    m_instances.clear();
+
+    CHECK_GL_ERRORS;
+
+    return true;
+}
+
+void
+ShadowPass::resetStats()
+{
+    m_stats = Stats();
+}
+
+const ShadowPass::Stats&
+ShadowPass::getStats() const
+{
+    return m_stats;
+}
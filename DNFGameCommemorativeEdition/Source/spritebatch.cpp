@@ -0,0 +1,150 @@
+#include "spritebatch.hpp"
+#include "constant.hpp"
+
+#include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+#include "streambuffer.hpp"
+
+// clang-format off
+
+static const int m_floats_per_vertex {5};
+
+// clang-format on
+
+SpriteBatch::SpriteBatch(ShaderProgram* shader)
+    : m_shader(shader)
+    , m_pending_texture_id(0)
+    , m_pending_is_text(false)
+{
+    m_model_uni_id = m_shader->getUniformId("M");
+    m_draw_text_uni_id = m_shader->getUniformId("drawText");
+
+    // Create the vertex array to record buffer assignments for the batch.
+    glGenVertexArrays(1, &m_sprite_batch_vao);
+    glBindVertexArray(m_sprite_batch_vao);
+
+    // Vertices are streamed on flush, the pointers are set per draw.
+    m_position_attrib_pos = m_shader->getAttribLocation("position");
+    glEnableVertexAttribArray(m_position_attrib_pos);
+
+    // texture coord
+    m_texture_coor_attrib_pos = m_shader->getAttribLocation("textureCoor");
+    glEnableVertexAttribArray(m_texture_coor_attrib_pos);
+
+    // Reset state to prevent rogue code from messing with *my* stuff!
+    glBindVertexArray(0);
+
+    CHECK_GL_ERRORS;
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    glDeleteVertexArrays(1, &m_sprite_batch_vao);
+}
+
+void
+SpriteBatch::setVertexAttribPointers(GLintptr base)
+{
+    GLsizei stride = sizeof(GLfloat) * m_floats_per_vertex;
+
+    // Specify the means of extracting the position values properly.
+    glVertexAttribPointer(m_position_attrib_pos, 3, GL_FLOAT, GL_FALSE, stride, (void*) base);
+
+    // texture coord
+    glVertexAttribPointer(m_texture_coor_attrib_pos,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          stride,
+                          (void*) (base + sizeof(GLfloat) * 3));
+}
+
+void
+SpriteBatch::submit(const glm::mat4& modelMat,
+                    GLuint textureId,
+                    const glm::vec4& uvRect,
+                    bool isText)
+{
+    if (!m_vertices.empty()
+        && (textureId != m_pending_texture_id || isText != m_pending_is_text))
+        flush();
+
+    m_pending_texture_id = textureId;
+    m_pending_is_text = isText;
+
+    // Quad planes are flipped in u, the node transforms rotate them back
+    for (int i = 0; i < UnitQuad::verticesCount; i++) {
+        float x = UnitQuad::corners[i * 2];
+        float y = UnitQuad::corners[i * 2 + 1];
+        glm::vec4 pos = modelMat * glm::vec4(x, y, 0.0f, 1.0f);
+
+        m_vertices.push_back(pos.x);
+        m_vertices.push_back(pos.y);
+        m_vertices.push_back(pos.z);
+        m_vertices.push_back(uvRect.x + (1.0f - x) * (uvRect.z - uvRect.x));
+        m_vertices.push_back(uvRect.y + y * (uvRect.w - uvRect.y));
+    }
+
+    m_stats.quads++;
+}
+
+void
+SpriteBatch::flush()
+{
+    if (m_vertices.empty())
+        return;
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_vertices.size() * sizeof(GLfloat));
+    GLintptr offset = StreamBuffer::upload(m_vertices.data(), size);
+
+    if (offset < 0) {
+        m_vertices.clear();
+
+        return;
+    }
+
+    // Draw transparent backgrounds in blend mode (alpha channel)
+    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
+    GLStateCache::depthMask(GL_FALSE);
+
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Texture unit 0, sampler2D in shader
+    GLStateCache::bindTexture2D(m_pending_texture_id);
+
+    // Vertices are already in world space
+    m_shader->set(m_model_uni_id, glm::mat4(1.0f));
+    m_shader->set(m_draw_text_uni_id, static_cast<GLint>(m_pending_is_text));
+
+    glBindVertexArray(m_sprite_batch_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, StreamBuffer::getBufferId());
+    setVertexAttribPointers(offset);
+
+    glDrawArrays(GL_TRIANGLES,
+                 0,
+                 static_cast<GLsizei>(m_vertices.size() / m_floats_per_vertex));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
+
+    m_vertices.clear();
+    m_stats.drawCalls++;
+
+    CHECK_GL_ERRORS;
+}
+
+void
+SpriteBatch::resetStats()
+{
+    m_stats = Stats();
+}
+
+const SpriteBatch::Stats&
+SpriteBatch::getStats() const
+{
+    return m_stats;
+}
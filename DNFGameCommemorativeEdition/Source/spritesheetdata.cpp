@@ -0,0 +1,137 @@
+#include "spritesheetdata.hpp"
+#include "constant.hpp"
+
+#include "json.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace fs = std::filesystem;
+
+SpriteSheetData::Sheet
+SpriteSheetData::load(const std::string& jsonPath)
+{
+    Sheet sheet;
+
+    if (!isBinaryStale(jsonPath) && loadBinary(getBinaryPath(jsonPath), sheet))
+        return sheet;
+
+    return loadJson(jsonPath);
+}
+
+bool
+SpriteSheetData::loadBinary(const std::string& binaryPath, Sheet& sheet)
+{
+    std::error_code error;
+    auto fileSize = fs::file_size(binaryPath, error);
+    if (error || fileSize < sizeof(Header))
+        return false;
+
+    std::vector<char> buffer(static_cast<size_t>(fileSize));
+
+    std::ifstream ifs(binaryPath, std::ios::binary);
+    if (!ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+        return false;
+
+    Header header;
+    std::memcpy(&header, buffer.data(), sizeof(Header));
+
+    if (header.magic != magic || header.version != version
+        || fileSize != sizeof(Header) + header.frameCount * sizeof(Frame)) {
+        std::cout << "Invalid sprite sheet binary " << binaryPath << std::endl;
+
+        return false;
+    }
+
+    sheet.width = header.sheetWidth;
+    sheet.height = header.sheetHeight;
+    sheet.frames.resize(header.frameCount);
+    std::memcpy(sheet.frames.data(),
+                buffer.data() + sizeof(Header),
+                header.frameCount * sizeof(Frame));
+
+    return true;
+}
+
+SpriteSheetData::Sheet
+SpriteSheetData::loadJson(const std::string& jsonPath)
+{
+    std::ifstream ifs(jsonPath);
+    json jsonParser = json::parse(ifs);
+
+    const json& frames = jsonParser[SSJsonKeys::frames];
+    const json& sheetSize = jsonParser[SSJsonKeys::meta][SSJsonKeys::size];
+
+    Sheet sheet;
+    sheet.width = sheetSize[SSJsonKeys::w].get<unsigned int>();
+    sheet.height = sheetSize[SSJsonKeys::h].get<unsigned int>();
+
+    sheet.frames.reserve(frames.size());
+    for (unsigned int i = 0; i < frames.size(); i++) {
+        const json& frameInfo = frames[std::to_string(i)];
+        const json& frameRect = frameInfo[SSJsonKeys::frame];
+        const json& trimRect = frameInfo[SSJsonKeys::spriteSourceSize];
+        const json& sourceSize = frameInfo[SSJsonKeys::sourceSize];
+
+        Frame frame;
+        frame.x = frameRect[SSJsonKeys::x].get<std::uint16_t>();
+        frame.y = frameRect[SSJsonKeys::y].get<std::uint16_t>();
+        frame.w = frameRect[SSJsonKeys::w].get<std::uint16_t>();
+        frame.h = frameRect[SSJsonKeys::h].get<std::uint16_t>();
+        frame.trimX = trimRect[SSJsonKeys::x].get<std::uint16_t>();
+        frame.trimY = trimRect[SSJsonKeys::y].get<std::uint16_t>();
+        frame.trimW = trimRect[SSJsonKeys::w].get<std::uint16_t>();
+        frame.trimH = trimRect[SSJsonKeys::h].get<std::uint16_t>();
+        frame.sourceW = sourceSize[SSJsonKeys::w].get<std::uint16_t>();
+        frame.sourceH = sourceSize[SSJsonKeys::h].get<std::uint16_t>();
+        frame.trimmed = frameInfo[SSJsonKeys::trimmed].get<bool>() ? 1 : 0;
+        frame.rotated = frameInfo[SSJsonKeys::rotated].get<bool>() ? 1 : 0;
+
+        sheet.frames.push_back(frame);
+    }
+
+    return sheet;
+}
+
+bool
+SpriteSheetData::writeBinary(const std::string& binaryPath, const Sheet& sheet)
+{
+    Header header;
+    header.magic = magic;
+    header.version = version;
+    header.frameCount = static_cast<std::uint32_t>(sheet.frames.size());
+    header.sheetWidth = static_cast<std::uint16_t>(sheet.width);
+    header.sheetHeight = static_cast<std::uint16_t>(sheet.height);
+
+    std::ofstream ofs(binaryPath, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    ofs.write(reinterpret_cast<const char*>(sheet.frames.data()),
+              static_cast<std::streamsize>(sheet.frames.size() * sizeof(Frame)));
+
+    return static_cast<bool>(ofs);
+}
+
+bool
+SpriteSheetData::isBinaryStale(const std::string& jsonPath)
+{
+    std::error_code error;
+    auto binaryTime = fs::last_write_time(getBinaryPath(jsonPath), error);
+    if (error)
+        return true;
+
+    auto jsonTime = fs::last_write_time(jsonPath, error);
+    if (error)
+        return false;
+
+    return binaryTime < jsonTime;
+}
+
+std::string
+SpriteSheetData::getBinaryPath(const std::string& jsonPath)
+{
+    return fs::path(jsonPath).replace_extension(SpriteSheetContent::binaryExtension).string();
+}
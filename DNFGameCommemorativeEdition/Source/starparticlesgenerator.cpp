@@ -2,35 +2,22 @@
 #include "gamewindow.hpp"
 #include "game.hpp"
 #include "constant.hpp"
+#include "shadercache.hpp"
 
 #include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+#include "streambuffer.hpp"
 
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
 
 #include <random>
 #include <cmath>
+#include <ctime>
+#include <limits>
 
 #define M_PI 3.14159265358979323846 /* pi */
 
-// clang-format off
-
-// Particles Generator vertex at the live area origin with texture coord
-static const GLfloat particles_generator_vertex_buffer_data[] =
-{
-    // triangle 1
-    // x,    y,    z,    u,    v,
-    0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-    1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-    0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-    // triangle 2
-    1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-    1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-    0.0f, 0.0f, 0.0f, 1.0f, 0.0f
-};
-
-// clang-format on
-
 static const unsigned int max_particles_num {100};
 static const unsigned int new_particles_per_time {16};
 static const float radius_stars_circles {300.0f};
@@ -47,19 +34,14 @@ StarParticlesGenerator::StarParticlesGenerator(ShaderProgram* shader)
     , m_shader(shader)
 {
     // Create particle shader
-    m_particle_shader.generateProgramObject();
-    m_particle_shader.attachVertexShader(ParticleShaderPath::vertexShader.c_str());
-    m_particle_shader.attachFragmentShader(ParticleShaderPath::fragmentShader.c_str());
-    m_particle_shader.link();
+    m_particle_shader = ShaderCache::acquire(ParticleShaderPath::vertexShader,
+                                             ParticleShaderPath::fragmentShader);
 
     // Set up the uniforms
-    m_particle_p_uni = m_particle_shader.getUniformLocation("P");
-    m_particle_v_uni = m_particle_shader.getUniformLocation("V");
-    m_particle_m_uni = m_particle_shader.getUniformLocation("M");
+    m_particle_m_uni = m_particle_shader->getUniformLocation("M");
 
     // Load texture
-    m_texture = Texture(TexturePath::starPNGPath);
-    m_texture.loadTexture();
+    m_texture = TextureCache::acquire(TexturePath::starPNGPath);
 
     // Reserve memory - size unchanged
     m_particles.reserve(max_particles_num);
@@ -74,61 +56,15 @@ StarParticlesGenerator::StarParticlesGenerator(ShaderProgram* shader)
     glGenVertexArrays(1, &m_particles_generator_vao);
     glBindVertexArray(m_particles_generator_vao);
 
-    // Create the particles generator vertex buffer
-    glGenBuffers(1, &m_particles_generator_basic_mesh_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_particles_generator_basic_mesh_vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 sizeof(particles_generator_vertex_buffer_data),
-                 particles_generator_vertex_buffer_data,
-                 GL_STATIC_DRAW);
-
-    // Specify the means of extracting the position values properly.
-    m_position_attrib_pos = m_particle_shader.getAttribLocation("position");
-    glEnableVertexAttribArray(m_position_attrib_pos);
-    glVertexAttribPointer(m_position_attrib_pos,
-                          3,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(particles_generator_vertex_buffer_data[0]) * 5,
-                          nullptr);
-
-    // texture coord
-    m_texture_coor_attrib_pos = m_particle_shader.getAttribLocation("textureCoor");
-    glEnableVertexAttribArray(m_texture_coor_attrib_pos);
-    glVertexAttribPointer(m_texture_coor_attrib_pos,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(particles_generator_vertex_buffer_data[0]) * 5,
-                          (void*) (sizeof(particles_generator_vertex_buffer_data[0]) * 3));
-
-    /*
-     * By default, the attribute divisor is 0 which tells OpenGL to update the content of the vertex
-     * attribute each iteration of the vertex shader. (Normal behavior new vertex come in)
-     *
-     * By setting this attribute to 1 we're telling OpenGL that we want to
-     * update the content of the vertex attribute when we start to render a new instance.
-     *
-     * By setting it to 2 we'd update the content every 2 instances and so on.
-     */
-    glVertexAttribDivisor(m_position_attrib_pos, 0);
-    glVertexAttribDivisor(m_texture_coor_attrib_pos, 0);
-
+    // The quad corners come from gl_VertexID, only the offset is per instance
     // pos offset
-    m_pos_offset_attrib_pos = m_particle_shader.getAttribLocation("posOffset");
+    m_pos_offset_attrib_pos = m_particle_shader->getAttribLocation("posOffset");
     glEnableVertexAttribArray(m_pos_offset_attrib_pos);
-    // Note that, glBindBuffer should be before glVertexAttribPointer !!!!!!!!!!
-    // The VBO containing the positions and sizes of the particles
-    glGenBuffers(1, &m_particles_generator_pos_offset_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_particles_generator_pos_offset_vbo);
-    // Initialize with empty (NULL) buffer : it will be updated later, each frame.
-    glBufferData(GL_ARRAY_BUFFER, max_particles_num * 3 * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(m_pos_offset_attrib_pos, 3, GL_FLOAT, GL_FALSE, 0, (void*) 0);
+    // Offsets are streamed each frame, the pointer is set per draw.
     glVertexAttribDivisor(m_pos_offset_attrib_pos, 1);
 
     // Reset state to prevent rogue code from messing with *my* stuff!
     glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     CHECK_GL_ERRORS;
 }
@@ -188,20 +124,15 @@ StarParticlesGenerator::processing()
             }
         }
     }
+}
 
-    // Update pos size
-    glEnableVertexAttribArray(m_pos_offset_attrib_pos);
-    glBindBuffer(GL_ARRAY_BUFFER, m_particles_generator_pos_offset_vbo);
-
-    glBufferSubData(GL_ARRAY_BUFFER,
-                    0,
-                    max_particles_num * sizeof(GLfloat) * 3,
-                    particle_pos_offset_data);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDisableVertexAttribArray(m_pos_offset_attrib_pos);
-
-    CHECK_GL_ERRORS;
+glm::vec4
+StarParticlesGenerator::getWorldBounds()
+{
+    return glm::vec4(std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max());
 }
 
 void
@@ -229,59 +160,52 @@ StarParticlesGenerator::translate(const glm::vec3& amount)
 void
 StarParticlesGenerator::draw()
 {
-    m_shader->disable();
-    m_particle_shader.enable();
+    m_particle_shader->enable();
+
+    glUniformMatrix4fv(m_particle_m_uni, 1, GL_FALSE, value_ptr(m_world_trans));
 
     processing();
 
-    // Draw transparent backgrounds in blend mode (alpha channel)
-    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
-    glDepthMask(GL_FALSE);
+    if (m_particles.empty()) {
+        m_shader->enable();
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        return;
+    }
 
-    m_texture.useTexture();
+    // Only the live particles, not the whole max_particles_num array
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_particles.size() * sizeof(GLfloat) * 3);
+    GLintptr offset = StreamBuffer::upload(particle_pos_offset_data, size);
 
-    // Draw the particules
-    glBindVertexArray(m_particles_generator_vao);
-    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(m_particles.size()));
-    glBindVertexArray(0);
+    if (offset < 0) {
+        m_shader->enable();
 
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+        return;
+    }
 
-    m_particle_shader.disable();
-    m_shader->enable();
-}
+    // Draw transparent backgrounds in blend mode (alpha channel)
+    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
+    GLStateCache::depthMask(GL_FALSE);
 
-void
-StarParticlesGenerator::updateParticleShaderModelMat(const glm::mat4& nodeTrans)
-{
-    m_shader->disable();
-    m_particle_shader.enable();
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    //-- Set ModelView matrix:
-    glUniformMatrix4fv(m_particle_m_uni, 1, GL_FALSE, value_ptr(nodeTrans));
+    m_texture->useTexture();
 
-    m_particle_shader.disable();
-    m_shader->enable();
+    // Draw the particules
+    glBindVertexArray(m_particles_generator_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, StreamBuffer::getBufferId());
+    glVertexAttribPointer(m_pos_offset_attrib_pos, 3, GL_FLOAT, GL_FALSE, 0, (void*) offset);
 
-    CHECK_GL_ERRORS;
-}
+    glDrawArraysInstanced(GL_TRIANGLES,
+                          0,
+                          UnitQuad::verticesCount,
+                          static_cast<GLsizei>(m_particles.size()));
 
-void
-StarParticlesGenerator::updateParticleShaderPVMat(const glm::mat4& pTrans, const glm::mat4& vTrans)
-{
-    m_shader->disable();
-    m_particle_shader.enable();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 
-    //-- Set PV matrix:
-    glUniformMatrix4fv(m_particle_p_uni, 1, GL_FALSE, value_ptr(pTrans));
-    glUniformMatrix4fv(m_particle_v_uni, 1, GL_FALSE, value_ptr(vTrans));
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
 
-    m_particle_shader.disable();
     m_shader->enable();
-
-    CHECK_GL_ERRORS
 }
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include "staticlayer.hpp"
+#include "constant.hpp"
+
+#include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+
+#include <gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// clang-format off
+
+static const int m_floats_per_vertex {5};
+
+// clang-format on
+
+StaticLayer::StaticLayer(const std::string& name, ShaderProgram* shader)
+    : GeometryNode(name)
+    , m_shader(shader)
+    , m_content_root(std::make_unique<SceneNode>(name + "_content"))
+    , m_dirty(true)
+    , m_vao(0)
+    , m_vbo(0)
+{
+    m_draw_text_uni_id = m_shader->getUniformId("drawText");
+}
+
+StaticLayer::~StaticLayer()
+{
+    releaseTiles();
+}
+
+void
+StaticLayer::addContent(SceneNode* node)
+{
+    m_content_root->addChild(node);
+    invalidate();
+}
+
+SceneNode*
+StaticLayer::getContentRoot()
+{
+    return m_content_root.get();
+}
+
+void
+StaticLayer::invalidate()
+{
+    m_dirty = true;
+}
+
+void
+StaticLayer::validate()
+{
+    m_dirty = false;
+}
+
+bool
+StaticLayer::isDirty() const
+{
+    return m_dirty;
+}
+
+void
+StaticLayer::releaseTiles()
+{
+    for (auto& tile : m_tiles) {
+        glDeleteFramebuffers(1, &tile.fbo);
+        glDeleteTextures(1, &tile.texture);
+        GLStateCache::onTextureDeleted(tile.texture);
+    }
+    m_tiles.clear();
+
+    if (m_vbo != 0)
+        glDeleteBuffers(1, &m_vbo);
+    if (m_vao != 0)
+        glDeleteVertexArrays(1, &m_vao);
+
+    m_vbo = 0;
+    m_vao = 0;
+}
+
+void
+StaticLayer::resize(const glm::vec4& bounds, GLfloat tileWidth)
+{
+    releaseTiles();
+
+    // Whole pixels, so a tile maps one to one onto the window
+    GLfloat left = std::floor(bounds.x);
+    GLfloat bottom = std::floor(bounds.y);
+    GLfloat right = std::ceil(bounds.z);
+    GLfloat top = std::ceil(bounds.w);
+    tileWidth = std::ceil(tileWidth);
+
+    if (right <= left || top <= bottom || tileWidth <= 0.0f)
+        return;
+
+    std::vector<GLfloat> vertices;
+
+    for (GLfloat x = left; x < right; x += tileWidth) {
+        Tile tile {glm::vec4(x, bottom, std::min(x + tileWidth, right), top), true, 0, 0};
+
+        GLsizei width = static_cast<GLsizei>(tile.bounds.z - tile.bounds.x);
+        GLsizei height = static_cast<GLsizei>(tile.bounds.w - tile.bounds.y);
+
+        glGenTextures(1, &tile.texture);
+        GLStateCache::bindTexture2D(tile.texture);
+
+        // Drawn at its own size, no filtering or mipmaps needed
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D,
+                     0,
+                     GL_RGBA,
+                     width,
+                     height,
+                     0,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     nullptr);
+
+        GLStateCache::bindTexture2D(0);
+
+        glGenFramebuffers(1, &tile.fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, tile.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER,
+                               GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D,
+                               tile.texture,
+                               0);
+        CHECK_FRAMEBUFFER_COMPLETENESS;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        // Rendered bottom row first, v0 is the bottom edge
+        const GLfloat x0 = tile.bounds.x;
+        const GLfloat y0 = tile.bounds.y;
+        const GLfloat x1 = tile.bounds.z;
+        const GLfloat y1 = tile.bounds.w;
+
+        // clang-format off
+        const GLfloat quad[] {
+            x0, y0, 0.0f, 0.0f, 0.0f,
+            x1, y0, 0.0f, 1.0f, 0.0f,
+            x1, y1, 0.0f, 1.0f, 1.0f,
+            x0, y0, 0.0f, 0.0f, 0.0f,
+            x1, y1, 0.0f, 1.0f, 1.0f,
+            x0, y1, 0.0f, 0.0f, 1.0f
+        };
+        // clang-format on
+
+        vertices.insert(vertices.end(), std::begin(quad), std::end(quad));
+        m_tiles.push_back(tile);
+    }
+
+    GLuint positionAttribPos = m_shader->getAttribLocation("position");
+    GLuint textureCoorAttribPos = m_shader->getAttribLocation("textureCoor");
+
+    glGenVertexArrays(1, &m_vao);
+    glBindVertexArray(m_vao);
+
+    glGenBuffers(1, &m_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 vertices.size() * sizeof(GLfloat),
+                 vertices.data(),
+                 GL_STATIC_DRAW);
+
+    // Specify the means of extracting the position values properly.
+    glEnableVertexAttribArray(positionAttribPos);
+    glVertexAttribPointer(positionAttribPos,
+                          3,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(GLfloat) * m_floats_per_vertex,
+                          nullptr);
+
+    // texture coord
+    glEnableVertexAttribArray(textureCoorAttribPos);
+    glVertexAttribPointer(textureCoorAttribPos,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(GLfloat) * m_floats_per_vertex,
+                          (void*) (sizeof(GLfloat) * 3));
+
+    // Reset state to prevent rogue code from messing with *my* stuff!
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERRORS;
+}
+
+glm::vec4
+StaticLayer::bindTile(size_t i)
+{
+    const Tile& tile = m_tiles[i];
+
+    glBindFramebuffer(GL_FRAMEBUFFER, tile.fbo);
+    glViewport(0,
+               0,
+               static_cast<GLsizei>(tile.bounds.z - tile.bounds.x),
+               static_cast<GLsizei>(tile.bounds.w - tile.bounds.y));
+
+    // Leaves the window clear color alone
+    const GLfloat transparent[] {0.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, transparent);
+
+    return tile.bounds;
+}
+
+glm::vec4
+StaticLayer::getTileWorldBounds(const Tile& tile) const
+{
+    // Content is rendered in the map space, only the node transform moves the tiles
+    glm::mat4 tileTrans = glm::translate(glm::mat4(1.0f),
+                                         glm::vec3(tile.bounds.x, tile.bounds.y, 0.0f));
+    tileTrans = glm::scale(tileTrans,
+                           glm::vec3(tile.bounds.z - tile.bounds.x,
+                                     tile.bounds.w - tile.bounds.y,
+                                     1.0f));
+
+    return getQuadBounds(m_world_trans * tileTrans);
+}
+
+bool
+StaticLayer::isVisible(const glm::vec4& viewRect)
+{
+    bool anyVisible {false};
+
+    for (auto& tile : m_tiles) {
+        tile.visible = overlaps(getTileWorldBounds(tile), viewRect);
+        anyVisible = anyVisible || tile.visible;
+    }
+
+    return anyVisible;
+}
+
+glm::vec4
+StaticLayer::getWorldBounds()
+{
+    glm::vec4 bounds {std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest()};
+
+    // Only what draw() will touch
+    for (const auto& tile : m_tiles) {
+        if (!tile.visible)
+            continue;
+
+        glm::vec4 tileBounds = getTileWorldBounds(tile);
+
+        bounds.x = std::min(bounds.x, tileBounds.x);
+        bounds.y = std::min(bounds.y, tileBounds.y);
+        bounds.z = std::max(bounds.z, tileBounds.z);
+        bounds.w = std::max(bounds.w, tileBounds.w);
+    }
+
+    return bounds;
+}
+
+SceneNode::RenderState
+StaticLayer::getRenderState()
+{
+    return {RenderProgram::Sprite, m_tiles.empty() ? 0 : m_tiles.front().texture};
+}
+
+void
+StaticLayer::draw()
+{
+    GLStateCache::depthMask(GL_FALSE);
+
+    // Tiles are premultiplied
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_shader->set(m_draw_text_uni_id, static_cast<GLint>(false));
+
+    glBindVertexArray(m_vao);
+
+    for (size_t i = 0; i < m_tiles.size(); i++) {
+        if (!m_tiles[i].visible)
+            continue;
+
+        GLStateCache::bindTexture2D(m_tiles[i].texture);
+        glDrawArrays(GL_TRIANGLES,
+                     static_cast<GLint>(i * UnitQuad::verticesCount),
+                     UnitQuad::verticesCount);
+    }
+
+    glBindVertexArray(0);
+
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
+
+    CHECK_GL_ERRORS;
+}
@@ -0,0 +1,202 @@
+#include "streambuffer.hpp"
+
+#include "glerrorcheck.hpp"
+
+#include <cstring>
+#include <iostream>
+
+// clang-format off
+
+// One second, only reached if the GPU is several frames behind
+static const GLuint64 m_fence_timeout {1000000000};
+
+// clang-format on
+
+static GLuint m_buffer {0};
+// Whole buffer when persistently mapped, nullptr when orphaning
+static GLubyte* m_mapped {nullptr};
+static GLsync m_fences[StreamBuffer::regionsCount] {};
+static unsigned int m_region {0};
+// Next free byte in the current region
+static GLintptr m_head {0};
+
+static StreamBuffer::Stats m_frame_stats;
+static StreamBuffer::Stats m_last_frame_stats;
+
+/*
+ * Blocks until the GPU is done with everything issued before the fence.
+ */
+static void
+waitForFence(GLsync& fence)
+{
+    if (fence == nullptr)
+        return;
+
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        m_frame_stats.waits++;
+
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, m_fence_timeout)
+               == GL_TIMEOUT_EXPIRED) {}
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+/*
+ * Let the driver hand out fresh storage, draws already issued keep the old one.
+ */
+static void
+orphan()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glBufferData(GL_ARRAY_BUFFER, StreamBuffer::regionSize, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void
+StreamBuffer::init()
+{
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    if (GLEW_ARB_buffer_storage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(GL_ARRAY_BUFFER, regionsCount * regionSize, nullptr, flags);
+        m_mapped = static_cast<GLubyte*>(
+            glMapBufferRange(GL_ARRAY_BUFFER, 0, regionsCount * regionSize, flags));
+
+        // Immutable storage cannot be respecified, start over for the fallback
+        if (m_mapped == nullptr) {
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        }
+    }
+
+    // Orphaning only ever writes one region
+    if (m_mapped == nullptr)
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERRORS;
+}
+
+void
+StreamBuffer::release()
+{
+    for (auto& fence : m_fences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    if (m_mapped != nullptr) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_mapped = nullptr;
+    }
+
+    glDeleteBuffers(1, &m_buffer);
+    m_buffer = 0;
+}
+
+void
+StreamBuffer::beginFrame()
+{
+    m_last_frame_stats = m_frame_stats;
+    m_frame_stats = Stats();
+
+    if (m_mapped != nullptr) {
+        m_region = (m_region + 1) % regionsCount;
+        waitForFence(m_fences[m_region]);
+    } else {
+        orphan();
+    }
+
+    m_head = 0;
+}
+
+void
+StreamBuffer::endFrame()
+{
+    if (m_mapped != nullptr)
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLintptr
+StreamBuffer::upload(const void* data, GLsizeiptr size)
+{
+    if (size > regionSize) {
+        std::cout << "StreamBuffer upload of " << size << " bytes does not fit in a region"
+                  << std::endl;
+
+        return -1;
+    }
+
+    GLintptr head = (m_head + alignment - 1) / alignment * alignment;
+
+    // Out of room mid frame, wait for the draws already issued from this region
+    if (head + size > regionSize) {
+        m_frame_stats.waits++;
+
+        if (m_mapped != nullptr)
+            glFinish();
+        else
+            orphan();
+
+        head = 0;
+    }
+
+    GLintptr offset = m_region * regionSize + head;
+
+    if (m_mapped != nullptr) {
+        std::memcpy(m_mapped + offset, data, static_cast<size_t>(size));
+#if (GL_SHIM)
+        GLShim::countMappedUpload(static_cast<size_t>(size));
+#endif
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    m_head = head + size;
+
+    m_frame_stats.bytes += static_cast<unsigned int>(size);
+    m_frame_stats.uploads++;
+
+    return offset;
+}
+
+GLuint
+StreamBuffer::getBufferId()
+{
+    return m_buffer;
+}
+
+bool
+StreamBuffer::isPersistentlyMapped()
+{
+    return m_mapped != nullptr;
+}
+
+const StreamBuffer::Stats&
+StreamBuffer::getStats()
+{
+    return m_last_frame_stats;
+}
+
+void
+StreamBuffer::printStats()
+{
+    std::cout << "StreamBuffer (last frame) bytes: " << m_last_frame_stats.bytes
+              << ", uploads: " << m_last_frame_stats.uploads
+              << ", waits: " << m_last_frame_stats.waits
+              << ", persistently mapped: " << (isPersistentlyMapped() ? "yes" : "no")
+              << std::endl;
+}
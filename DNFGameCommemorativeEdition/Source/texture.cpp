@@ -1,4 +1,5 @@
 #include "texture.hpp"
+#include "glstatecache.hpp"
 
 #include "stb_image.h"
 
@@ -11,6 +12,7 @@ Texture::Texture()
     , m_height(0)
     , m_bit_depth(0)
     , m_file_location("")
+    , m_uv_rect(0.0f, 0.0f, 1.0f, 1.0f)
 {}
 
 Texture::Texture(std::string fileLocation)
@@ -19,6 +21,17 @@ Texture::Texture(std::string fileLocation)
     , m_height(0)
     , m_bit_depth(0)
     , m_file_location(fileLocation)
+    , m_uv_rect(0.0f, 0.0f, 1.0f, 1.0f)
+{}
+
+Texture::Texture(std::shared_ptr<Texture> atlas, int width, int height, const glm::vec4& uvRect)
+    : m_texture_id(atlas->m_texture_id)
+    , m_width(width)
+    , m_height(height)
+    , m_bit_depth(4)
+    , m_file_location(atlas->m_file_location)
+    , m_uv_rect(uvRect)
+    , m_atlas(atlas)
 {}
 
 void
@@ -36,15 +49,35 @@ Texture::loadTexture()
         return;
     }
 
+    uploadTexture(textureData, GL_REPEAT);
+
+    // Free image
+    stbi_image_free(textureData);
+}
+
+void
+Texture::loadTexture(const unsigned char* rgbaData, int width, int height)
+{
+    m_width = width;
+    m_height = height;
+    m_bit_depth = 4;
+
+    // Pages pad their sub-images themselves, never wrap into the opposite edge
+    uploadTexture(rgbaData, GL_CLAMP_TO_EDGE);
+}
+
+void
+Texture::uploadTexture(const unsigned char* rgbaData, GLint wrapMode)
+{
     // Bind texture
     glGenTextures(1, &m_texture_id);
-    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    GLStateCache::bindTexture2D(m_texture_id);
 
     // How to handle texture when sampling across the border
     // GL_TEXTURE_WRAP_S -> x axis
     // GL_TEXTURE_WRAP_T -> y axis
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
 
     // Texture filtering can be set for magnifying and minifying operations
     // (when scaling up or downwards)
@@ -60,34 +93,34 @@ Texture::loadTexture()
                  0,
                  GL_RGBA,
                  GL_UNSIGNED_BYTE,
-                 textureData);
+                 rgbaData);
     glGenerateMipmap(GL_TEXTURE_2D);
 
     // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Free image
-    stbi_image_free(textureData);
+    GLStateCache::bindTexture2D(0);
 }
 
 void
 Texture::useTexture()
 {
-    // Texture Unit fo sampler2D in shader
-    glActiveTexture(GL_TEXTURE0);
-    // Bind texture to texture Unit
-    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    // Bind texture to texture unit 0, sampler2D in shader
+    GLStateCache::bindTexture2D(m_texture_id);
 }
 
 void
 Texture::clearTexture()
 {
-    // Delete texture from memory
-    glDeleteTextures(1, &m_texture_id);
+    // Delete texture from memory, views leave it to their atlas page
+    if (m_atlas == nullptr && m_texture_id != 0) {
+        GLStateCache::onTextureDeleted(m_texture_id);
+        glDeleteTextures(1, &m_texture_id);
+    }
+    m_atlas.reset();
 
     m_texture_id = 0;
     m_width = 0;
     m_height = 0;
     m_bit_depth = 0;
     m_file_location = "";
+    m_uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 }
\ No newline at end of file
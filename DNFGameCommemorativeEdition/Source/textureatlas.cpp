@@ -0,0 +1,291 @@
+#include "textureatlas.hpp"
+#include "constant.hpp"
+
+#include "stb_image.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <unordered_map>
+
+// One segment of the packed outline, everything below y is taken
+struct SkylineNode
+{
+    int x;
+    int y;
+    int width;
+};
+
+struct AtlasImage
+{
+    std::string filePath;
+    int width;
+    int height;
+    unsigned char* data;
+};
+
+static std::shared_ptr<Texture> m_atlas_page;
+static unsigned int m_atlas_packed_count {0};
+
+static std::unordered_map<std::string, TextureAtlas::Region>&
+getRegions()
+{
+    static auto* regions = new std::unordered_map<std::string, TextureAtlas::Region>();
+
+    return *regions;
+}
+
+/*
+ * Returns the y a width x height rect rests at when its left edge is at skyline[index],
+ * or -1 if it runs out of the page.
+ */
+static int
+fitSkyline(const std::vector<SkylineNode>& skyline,
+           size_t index,
+           int width,
+           int height,
+           int pageWidth,
+           int pageHeight)
+{
+    if (skyline[index].x + width > pageWidth)
+        return -1;
+
+    int y {skyline[index].y};
+    int widthLeft {width};
+    for (size_t i = index; widthLeft > 0; i++) {
+        if (i >= skyline.size())
+            return -1;
+
+        y = std::max(y, skyline[i].y);
+        if (y + height > pageHeight)
+            return -1;
+
+        widthLeft -= skyline[i].width;
+    }
+
+    return y;
+}
+
+static void
+addSkylineLevel(std::vector<SkylineNode>& skyline,
+                size_t index,
+                int x,
+                int y,
+                int width,
+                int height)
+{
+    skyline.insert(skyline.begin() + index, SkylineNode {x, y + height, width});
+
+    // Cut the segments now covered by the new one
+    for (size_t i = index + 1; i < skyline.size();) {
+        int previousEnd {skyline[i - 1].x + skyline[i - 1].width};
+        if (skyline[i].x >= previousEnd)
+            break;
+
+        int shrink {previousEnd - skyline[i].x};
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+
+        if (skyline[i].width > 0)
+            break;
+
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+}
+
+/*
+ * Bottom-left rule, lowest resulting top edge first, then the narrowest segment.
+ */
+static bool
+packSkyline(std::vector<SkylineNode>& skyline,
+            int width,
+            int height,
+            int pageWidth,
+            int pageHeight,
+            int& x,
+            int& y)
+{
+    int bestTop {INT_MAX};
+    int bestSegmentWidth {INT_MAX};
+    size_t bestIndex {0};
+    int bestY {-1};
+
+    for (size_t i = 0; i < skyline.size(); i++) {
+        int fitY {fitSkyline(skyline, i, width, height, pageWidth, pageHeight)};
+        if (fitY < 0)
+            continue;
+
+        if (fitY + height < bestTop
+            || (fitY + height == bestTop && skyline[i].width < bestSegmentWidth)) {
+            bestTop = fitY + height;
+            bestSegmentWidth = skyline[i].width;
+            bestIndex = i;
+            bestY = fitY;
+        }
+    }
+
+    if (bestY < 0)
+        return false;
+
+    x = skyline[bestIndex].x;
+    y = bestY;
+    addSkylineLevel(skyline, bestIndex, x, y, width, height);
+
+    return true;
+}
+
+/*
+ * Copy the image into the page at (x, y) and extrude its border into the padding ring.
+ */
+static void
+blitExtruded(std::vector<unsigned char>& page,
+             int pageWidth,
+             const AtlasImage& image,
+             int x,
+             int y,
+             int padding)
+{
+    for (int py = -padding; py < image.height + padding; py++) {
+        int srcY {std::clamp(py, 0, image.height - 1)};
+        for (int px = -padding; px < image.width + padding; px++) {
+            int srcX {std::clamp(px, 0, image.width - 1)};
+
+            const unsigned char* src = image.data + (srcY * image.width + srcX) * 4;
+            unsigned char* dst = page.data() + ((y + py) * pageWidth + (x + px)) * 4;
+            std::copy(src, src + 4, dst);
+        }
+    }
+}
+
+void
+TextureAtlas::build(const std::vector<std::string>& filePaths)
+{
+    const int padding {TextureAtlasContent::padding};
+    const int pageWidth {TextureAtlasContent::pageWidth};
+
+    GLint maxTextureSize {0};
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    const int maxPageHeight {std::min(TextureAtlasContent::maxPageHeight, maxTextureSize)};
+
+    // Always load as RGBA, some of the labels are palette PNGs
+    std::vector<AtlasImage> images;
+    for (const auto& filePath : filePaths) {
+        int width, height, bitDepth;
+        unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &bitDepth, 4);
+        if (data == nullptr) {
+            std::cout << "Failed to find: " << filePath << std::endl;
+            continue;
+        }
+
+        images.push_back(AtlasImage {filePath, width, height, data});
+    }
+
+    // Tallest first packs tighter
+    std::sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b) {
+        return a.height > b.height;
+    });
+
+    std::vector<SkylineNode> skyline {SkylineNode {0, 0, pageWidth}};
+    std::vector<glm::ivec2> positions(images.size(), glm::ivec2(-1));
+    int usedHeight {0};
+
+    for (size_t i = 0; i < images.size(); i++) {
+        int x, y;
+        if (!packSkyline(skyline,
+                         images[i].width + 2 * padding,
+                         images[i].height + 2 * padding,
+                         pageWidth,
+                         maxPageHeight,
+                         x,
+                         y)) {
+            std::cout << "TextureAtlas is full, not packed: " << images[i].filePath << std::endl;
+            continue;
+        }
+
+        positions[i] = glm::ivec2(x + padding, y + padding);
+        usedHeight = std::max(usedHeight, y + images[i].height + 2 * padding);
+    }
+
+    if (usedHeight > 0) {
+        int pageHeight {1};
+        while (pageHeight < usedHeight)
+            pageHeight *= 2;
+
+        std::vector<unsigned char> pixels(static_cast<size_t>(pageWidth) * pageHeight * 4, 0);
+
+        auto& regions = getRegions();
+        for (size_t i = 0; i < images.size(); i++) {
+            if (positions[i].x < 0)
+                continue;
+
+            blitExtruded(pixels, pageWidth, images[i], positions[i].x, positions[i].y, padding);
+
+            glm::vec4 uvRect(static_cast<float>(positions[i].x) / pageWidth,
+                             static_cast<float>(positions[i].y) / pageHeight,
+                             static_cast<float>(positions[i].x + images[i].width) / pageWidth,
+                             static_cast<float>(positions[i].y + images[i].height) / pageHeight);
+
+            regions[images[i].filePath] = Region {images[i].width, images[i].height, uvRect};
+            m_atlas_packed_count++;
+        }
+
+        m_atlas_page = std::make_shared<Texture>();
+        m_atlas_page->loadTexture(pixels.data(), pageWidth, pageHeight);
+    }
+
+    for (auto& image : images) {
+        stbi_image_free(image.data);
+    }
+}
+
+bool
+TextureAtlas::findRegion(const std::string& filePath, Region& region)
+{
+    auto& regions = getRegions();
+
+    auto it = regions.find(filePath);
+    if (it == regions.end())
+        return false;
+
+    region = it->second;
+
+    return true;
+}
+
+std::shared_ptr<Texture>
+TextureAtlas::getPage()
+{
+    return m_atlas_page;
+}
+
+void
+TextureAtlas::release()
+{
+    if (m_atlas_page != nullptr)
+        m_atlas_page->clearTexture();
+
+    m_atlas_page.reset();
+    getRegions().clear();
+    m_atlas_packed_count = 0;
+}
+
+void
+TextureAtlas::printStats()
+{
+    if (m_atlas_page == nullptr)
+        return;
+
+    std::cout << "TextureAtlas packed images: " << m_atlas_packed_count
+              << ", page: " << m_atlas_page->getTextureWidth() << "x"
+              << m_atlas_page->getTextureHeight() << std::endl;
+}
@@ -0,0 +1,100 @@
+#include "texturecache.hpp"
+#include "textureatlas.hpp"
+
+#include <iostream>
+#include <unordered_map>
+
+struct CacheEntry
+{
+    std::weak_ptr<Texture> texture;
+    size_t bytes;
+};
+
+static TextureCache::Stats m_cache_stats {0, 0, 0, 0};
+
+// Heap allocated on purpose, handles can still be released during static destruction
+// (Game is owned by a static shared_ptr in GameWindow).
+static std::unordered_map<std::string, CacheEntry>&
+getCacheEntries()
+{
+    static auto* entries = new std::unordered_map<std::string, CacheEntry>();
+
+    return *entries;
+}
+
+std::shared_ptr<Texture>
+TextureCache::acquire(const std::string& fileLocation)
+{
+    auto& entries = getCacheEntries();
+
+    auto it = entries.find(fileLocation);
+    if (it != entries.end()) {
+        if (auto texture = it->second.texture.lock()) {
+            m_cache_stats.hits++;
+
+            return texture;
+        }
+    }
+
+    m_cache_stats.misses++;
+
+    // Packed files become views of the atlas page
+    Texture* newTexture;
+    TextureAtlas::Region region;
+    if (TextureAtlas::findRegion(fileLocation, region)) {
+        newTexture = new Texture(TextureAtlas::getPage(),
+                                 region.width,
+                                 region.height,
+                                 region.uvRect);
+    } else {
+        newTexture = new Texture(fileLocation);
+        newTexture->loadTexture();
+    }
+
+    size_t bytes = newTexture->getTextureByteSize();
+
+    m_cache_stats.residentTextures++;
+    m_cache_stats.residentBytes += bytes;
+
+    // Release the entry together with the last handle
+    std::shared_ptr<Texture> texture(newTexture, [fileLocation, bytes](Texture* t) {
+        auto& entries = getCacheEntries();
+        auto it = entries.find(fileLocation);
+        if (it != entries.end() && it->second.texture.expired())
+            entries.erase(it);
+
+        m_cache_stats.residentTextures--;
+        m_cache_stats.residentBytes -= bytes;
+
+        delete t;
+    });
+
+    entries[fileLocation] = CacheEntry {texture, bytes};
+
+    return texture;
+}
+
+TextureCache::Stats
+TextureCache::getStats()
+{
+    TextureCache::Stats stats = m_cache_stats;
+
+    // The atlas page backs every packed file, its views count no bytes of their own
+    std::shared_ptr<Texture> page = TextureAtlas::getPage();
+    if (page != nullptr) {
+        stats.residentTextures++;
+        stats.residentBytes += page->getTextureByteSize();
+    }
+
+    return stats;
+}
+
+void
+TextureCache::printStats()
+{
+    TextureCache::Stats stats = getStats();
+
+    std::cout << "TextureCache hits: " << stats.hits << ", misses: " << stats.misses
+              << ", resident textures: " << stats.residentTextures
+              << ", resident bytes: " << stats.residentBytes << std::endl;
+}
@@ -0,0 +1,220 @@
+#include "tilemap.hpp"
+
+#include "glerrorcheck.hpp"
+#include "glstatecache.hpp"
+
+#include <gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// clang-format off
+
+static const int m_floats_per_vertex {5};
+
+// clang-format on
+
+TileMap::TileMap(const std::string& name, ShaderProgram* shader)
+    : GeometryNode(name)
+    , m_shader(shader)
+    , m_tiles_count(0)
+{
+    m_draw_text_uni_id = m_shader->getUniformId("drawText");
+}
+
+TileMap::~TileMap()
+{
+    for (auto& chunk : m_chunks) {
+        glDeleteBuffers(1, &chunk.vbo);
+        glDeleteVertexArrays(1, &chunk.vao);
+    }
+}
+
+void
+TileMap::addTile(const glm::vec2& origin,
+                 const glm::vec2& size,
+                 const std::shared_ptr<Texture>& texture)
+{
+    int column = static_cast<int>(std::floor(origin.x / chunkWidth));
+    GLuint textureId = texture->getTextureId();
+
+    auto chunk = std::find_if(m_chunks.begin(), m_chunks.end(), [&](const Chunk& c) {
+        return c.column == column && c.textureId == textureId;
+    });
+
+    glm::vec4 bounds {origin, origin + size};
+
+    if (chunk == m_chunks.end()) {
+        m_chunks.push_back({column, textureId, bounds, true, {}, 0, 0, 0});
+        chunk = m_chunks.end() - 1;
+    } else {
+        chunk->bounds.x = std::min(chunk->bounds.x, bounds.x);
+        chunk->bounds.y = std::min(chunk->bounds.y, bounds.y);
+        chunk->bounds.z = std::max(chunk->bounds.z, bounds.z);
+        chunk->bounds.w = std::max(chunk->bounds.w, bounds.w);
+    }
+
+    if (std::find(m_textures.begin(), m_textures.end(), texture) == m_textures.end())
+        m_textures.push_back(texture);
+
+    // Images are stored top row first, v0 goes to the top edge
+    const glm::vec4& uv = texture->getUVRect();
+    const GLfloat x0 = origin.x;
+    const GLfloat y0 = origin.y;
+    const GLfloat x1 = origin.x + size.x;
+    const GLfloat y1 = origin.y + size.y;
+
+    // clang-format off
+    const GLfloat quad[] {
+        x0, y0, 0.0f, uv.x, uv.w,
+        x1, y0, 0.0f, uv.z, uv.w,
+        x1, y1, 0.0f, uv.z, uv.y,
+        x0, y0, 0.0f, uv.x, uv.w,
+        x1, y1, 0.0f, uv.z, uv.y,
+        x0, y1, 0.0f, uv.x, uv.y
+    };
+    // clang-format on
+
+    chunk->vertices.insert(chunk->vertices.end(), std::begin(quad), std::end(quad));
+    m_tiles_count++;
+}
+
+void
+TileMap::build()
+{
+    GLuint positionAttribPos = m_shader->getAttribLocation("position");
+    GLuint textureCoorAttribPos = m_shader->getAttribLocation("textureCoor");
+
+    for (auto& chunk : m_chunks) {
+        if (chunk.vao != 0)
+            continue;
+
+        glGenVertexArrays(1, &chunk.vao);
+        glBindVertexArray(chunk.vao);
+
+        glGenBuffers(1, &chunk.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glBufferData(GL_ARRAY_BUFFER,
+                     chunk.vertices.size() * sizeof(GLfloat),
+                     chunk.vertices.data(),
+                     GL_STATIC_DRAW);
+
+        // Specify the means of extracting the position values properly.
+        glEnableVertexAttribArray(positionAttribPos);
+        glVertexAttribPointer(positionAttribPos,
+                              3,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              sizeof(GLfloat) * m_floats_per_vertex,
+                              nullptr);
+
+        // texture coord
+        glEnableVertexAttribArray(textureCoorAttribPos);
+        glVertexAttribPointer(textureCoorAttribPos,
+                              2,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              sizeof(GLfloat) * m_floats_per_vertex,
+                              (void*) (sizeof(GLfloat) * 3));
+
+        chunk.verticesCount = static_cast<GLsizei>(chunk.vertices.size() / m_floats_per_vertex);
+
+        // The GPU copy is all that is needed from now on
+        std::vector<GLfloat>().swap(chunk.vertices);
+    }
+
+    // Reset state to prevent rogue code from messing with *my* stuff!
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERRORS;
+}
+
+glm::vec4
+TileMap::getChunkWorldBounds(const Chunk& chunk) const
+{
+    // Tiles are baked in the map space, only the node transform moves them
+    glm::mat4 chunkTrans = glm::translate(glm::mat4(1.0f),
+                                          glm::vec3(chunk.bounds.x, chunk.bounds.y, 0.0f));
+    chunkTrans = glm::scale(chunkTrans,
+                            glm::vec3(chunk.bounds.z - chunk.bounds.x,
+                                      chunk.bounds.w - chunk.bounds.y,
+                                      1.0f));
+
+    return getQuadBounds(m_world_trans * chunkTrans);
+}
+
+bool
+TileMap::isVisible(const glm::vec4& viewRect)
+{
+    bool anyVisible {false};
+
+    for (auto& chunk : m_chunks) {
+        chunk.visible = overlaps(getChunkWorldBounds(chunk), viewRect);
+        anyVisible = anyVisible || chunk.visible;
+    }
+
+    return anyVisible;
+}
+
+glm::vec4
+TileMap::getWorldBounds()
+{
+    glm::vec4 bounds {std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest(),
+                      std::numeric_limits<float>::lowest()};
+
+    // Only what draw() will touch
+    for (const auto& chunk : m_chunks) {
+        if (!chunk.visible)
+            continue;
+
+        glm::vec4 chunkBounds = getChunkWorldBounds(chunk);
+
+        bounds.x = std::min(bounds.x, chunkBounds.x);
+        bounds.y = std::min(bounds.y, chunkBounds.y);
+        bounds.z = std::max(bounds.z, chunkBounds.z);
+        bounds.w = std::max(bounds.w, chunkBounds.w);
+    }
+
+    return bounds;
+}
+
+SceneNode::RenderState
+TileMap::getRenderState()
+{
+    // All the tiles are normally on one atlas page
+    return {RenderProgram::Sprite, m_chunks.empty() ? 0 : m_chunks.front().textureId};
+}
+
+void
+TileMap::draw()
+{
+    // Draw transparent backgrounds in blend mode (alpha channel)
+    // https://stackoverflow.com/questions/3388294/opengl-question-about-the-usage-of-gldepthmask
+    GLStateCache::depthMask(GL_FALSE);
+
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_shader->set(m_draw_text_uni_id, static_cast<GLint>(false));
+
+    for (const auto& chunk : m_chunks) {
+        if (!chunk.visible)
+            continue;
+
+        GLStateCache::bindTexture2D(chunk.textureId);
+
+        glBindVertexArray(chunk.vao);
+        glDrawArrays(GL_TRIANGLES, 0, chunk.verticesCount);
+    }
+
+    glBindVertexArray(0);
+
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::disable(GL_BLEND);
+
+    CHECK_GL_ERRORS;
+}
@@ -0,0 +1,166 @@
+/*
+ * Scene two rendered with GLShim in Record mode, no window, no GL context and no sound.
+ *
+ * Links the engine without Game and GameWindow, the few statics the scenes reach for are
+ * defined below. Run from the game directory, the resource paths are relative to it.
+ * Returns non zero when a per frame GLShim counter is off.
+ */
+
+#include "scenemanager.hpp"
+#include "camerauniformbuffer.hpp"
+#include "constant.hpp"
+#include "game.hpp"
+#include "glshim.hpp"
+#include "glstatecache.hpp"
+#include "shaderprogram.hpp"
+#include "streambuffer.hpp"
+#include "textureatlas.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <string>
+
+// clang-format off
+
+static const float m_framebuffer_width  {1200.0f};
+static const float m_framebuffer_height {900.0f};
+static const float m_frame_delta_time   {1.0f / 60.0f};
+static const int m_frames               {30};
+
+// Regression gates, measured at 39 draw calls and 6 program switches for 49 visible nodes
+static const unsigned int m_draw_call_budget      {40};
+static const unsigned int m_program_switch_budget {6};
+
+// clang-format on
+
+//----------------------------------------------------------------------------------------
+// Stand ins for Game, GameWindow and GLFW
+
+irrklang::ISoundEngine*
+Game::getSoundEngine()
+{
+    return nullptr;
+}
+
+void
+Game::enableKeyBoardEvent(bool)
+{}
+
+bool
+Game::getEnableKeyBoardEvent()
+{
+    return false;
+}
+
+float
+GameWindow::getDeltaTime()
+{
+    return m_frame_delta_time;
+}
+
+extern "C" void
+glfwSetWindowShouldClose(GLFWwindow*, int)
+{}
+
+//----------------------------------------------------------------------------------------
+static int m_failures {0};
+
+static void
+check(bool condition, const std::string& what)
+{
+    if (condition)
+        return;
+
+    std::cerr << "FAILED: " << what << std::endl;
+    m_failures++;
+}
+
+//----------------------------------------------------------------------------------------
+int
+main()
+{
+    check(GLShim::getMode() == GLShim::Mode::Record, "GLShim starts in Record");
+
+    ShaderProgram shader;
+    shader.generateProgramObject();
+    shader.attachVertexShader("Resource/Shaders/shader.vert");
+    shader.attachFragmentShader("Resource/Shaders/shader.frag");
+    shader.link();
+
+    CameraUniformBuffer cameraUbo;
+    cameraUbo.init();
+    CameraUniformBuffer::bindProgram(shader);
+
+    StreamBuffer::init();
+    TextureAtlas::build(TextureAtlasContent::filePaths);
+
+    glm::mat4 proj = glm::ortho(0.0f, m_framebuffer_width, 0.0f, m_framebuffer_height, -1.0f, 1.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f),
+                                 glm::vec3(0.0f, 0.0f, -1.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+
+    SceneManager sceneManager(&shader,
+                              m_framebuffer_width,
+                              m_framebuffer_height,
+                              nullptr,
+                              &cameraUbo);
+    sceneManager.constructScenes();
+    sceneManager.setCurrentSceneState(SceneManager::CurrentSceneState::SceneTwoPrep);
+
+    // Same frame as Game::draw()
+    for (int frame = 0; frame < m_frames; frame++) {
+        GLStateCache::beginFrame();
+        GLShim::beginFrame();
+        StreamBuffer::beginFrame();
+
+        shader.enable();
+        cameraUbo.update(proj, view);
+        sceneManager.setViewRect(
+            glm::vec4(0.0f, 0.0f, m_framebuffer_width, m_framebuffer_height));
+        sceneManager.scrollBackground(0.0f);
+        sceneManager.drawCurrentScene();
+        StreamBuffer::endFrame();
+        shader.disable();
+    }
+
+    // Close the last frame
+    GLShim::beginFrame();
+
+    const GLShim::Stats& stats = GLShim::getStats();
+    const SceneManager::TraversalStats& traversal = sceneManager.getTraversalStats();
+
+    GLShim::printStats();
+    sceneManager.printTraversalStats();
+
+    check(sceneManager.getCurrentSceneState() == SceneManager::CurrentSceneState::SceneTwoReady,
+          "scene two is ready");
+    check(traversal.visibleNodes > 0, "scene two has visible nodes");
+    check(stats.drawCalls > 0, "scene two draws");
+    // Sprites are batched, a draw call per visible node means batching broke
+    check(stats.drawCalls < traversal.visibleNodes, "fewer draw calls than visible nodes");
+    check(stats.drawCalls <= m_draw_call_budget,
+          "at most " + std::to_string(m_draw_call_budget) + " draw calls, got "
+              + std::to_string(stats.drawCalls));
+    check(stats.programSwitches > 0, "programs are switched");
+    check(stats.programSwitches <= m_program_switch_budget,
+          "at most " + std::to_string(m_program_switch_budget) + " program switches, got "
+              + std::to_string(stats.programSwitches));
+    check(stats.binds > 0, "buffers and textures are bound");
+    check(stats.bufferUploadBytes > 0, "vertices are uploaded");
+    // The atlas and the sprite sheets are uploaded once, not per frame
+    check(stats.textureUploadBytes == 0, "no texture uploads after the first frame");
+
+    StreamBuffer::release();
+    TextureAtlas::release();
+
+    if (m_failures > 0)
+        return 1;
+
+    std::cout << "Scene two record test passed" << std::endl;
+    return 0;
+}
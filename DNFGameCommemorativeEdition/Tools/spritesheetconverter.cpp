@@ -0,0 +1,117 @@
+/*
+ * Offline converter from the TexturePacker sprite sheet json to the SpriteSheetData binary.
+ *
+ * Run from the game directory, paths are relative to it like in the game:
+ *     SpriteSheetConverter                  convert the sheets whose binary is missing or stale
+ *     SpriteSheetConverter --force          convert every sheet
+ *     SpriteSheetConverter --bench [n]      time n loads of every sheet from json and binary
+ */
+
+#include "spritesheetdata.hpp"
+#include "constant.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// clang-format off
+
+static const std::string m_force_option {"--force"};
+static const std::string m_bench_option {"--bench"};
+
+static const int m_default_bench_iterations {200};
+
+// clang-format on
+
+static int
+convert(bool force)
+{
+    int failed = 0;
+
+    for (const auto& jsonPath : SpriteSheetContent::jsonPaths) {
+        if (!force && !SpriteSheetData::isBinaryStale(jsonPath)) {
+            std::cout << "Up to date " << jsonPath << std::endl;
+            continue;
+        }
+
+        SpriteSheetData::Sheet sheet = SpriteSheetData::loadJson(jsonPath);
+        std::string binaryPath = SpriteSheetData::getBinaryPath(jsonPath);
+
+        if (!SpriteSheetData::writeBinary(binaryPath, sheet)) {
+            std::cout << "Failed to write " << binaryPath << std::endl;
+            failed++;
+            continue;
+        }
+
+        std::cout << "Converted " << jsonPath << " -> " << binaryPath << " ("
+                  << sheet.frames.size() << " frames)" << std::endl;
+    }
+
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int
+bench(int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+
+    double jsonTotalMs = 0.0;
+    double binaryTotalMs = 0.0;
+
+    for (const auto& jsonPath : SpriteSheetContent::jsonPaths) {
+        std::string binaryPath = SpriteSheetData::getBinaryPath(jsonPath);
+
+        SpriteSheetData::Sheet binarySheet;
+        if (SpriteSheetData::isBinaryStale(jsonPath)
+            || !SpriteSheetData::loadBinary(binaryPath, binarySheet)) {
+            std::cout << "Missing or stale binary for " << jsonPath << ", convert first"
+                      << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        // Frame count also keeps the loads from being optimised away
+        size_t frames = 0;
+
+        auto jsonStart = Clock::now();
+        for (int i = 0; i < iterations; i++)
+            frames += SpriteSheetData::loadJson(jsonPath).frames.size();
+        auto jsonEnd = Clock::now();
+
+        for (int i = 0; i < iterations; i++) {
+            SpriteSheetData::Sheet sheet;
+            SpriteSheetData::loadBinary(binaryPath, sheet);
+            frames += sheet.frames.size();
+        }
+        auto binaryEnd = Clock::now();
+
+        double jsonMs = std::chrono::duration<double, std::milli>(jsonEnd - jsonStart).count()
+                        / iterations;
+        double binaryMs = std::chrono::duration<double, std::milli>(binaryEnd - jsonEnd).count()
+                          / iterations;
+
+        jsonTotalMs += jsonMs;
+        binaryTotalMs += binaryMs;
+
+        std::cout << jsonPath << " (" << frames / (2 * iterations) << " frames): json " << jsonMs
+                  << " ms, binary " << binaryMs << " ms" << std::endl;
+    }
+
+    std::cout << "All sheets: json " << jsonTotalMs << " ms, binary " << binaryTotalMs
+              << " ms, " << jsonTotalMs / binaryTotalMs << "x" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+    if (argc > 1 && argv[1] == m_bench_option) {
+        int iterations = argc > 2 ? std::atoi(argv[2]) : m_default_bench_iterations;
+
+        return bench(iterations > 0 ? iterations : m_default_bench_iterations);
+    }
+
+    return convert(argc > 1 && argv[1] == m_force_option);
+}
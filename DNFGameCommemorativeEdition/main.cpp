@@ -4,6 +4,7 @@
 
 #include "gamewindow.hpp"
 #include "game.hpp"
+#include "constant.hpp"
 
 // Window dimensions
 const GLint WIDTH = 1200, HEIGHT = 900;
@@ -11,6 +12,6 @@ const GLint WIDTH = 1200, HEIGHT = 900;
 int
 main(int argc, char** argv)
 {
-    GameWindow::launch(argc, argv, new Game(), WIDTH, HEIGHT, "DNF Yeah!");
+    GameWindow::launch(argc, argv, new Game(), WIDTH, HEIGHT, "DNF Yeah!", FPS::fps);
     return 0;
 }
\ No newline at end of file